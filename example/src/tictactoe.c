@@ -18,6 +18,7 @@ int main(int argc, char *argv[]) {
     SSGE_WindowResizable(false);
     SSGE_WindowFullscreen(false);
     SSGE_SetManualUpdate(true);
+    SSGE_SetIdleMode(true);
     SSGE_SetBackgroundColor((SSGE_Color){23, 15, 71, 255});
 
     // Load fonts with sizes 32 and 64
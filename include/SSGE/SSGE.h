@@ -7,11 +7,17 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
 
 #include "SSGE/SSGE_config.h"
 #include "SSGE/SSGE_types.h"
 
 #include "SSGE/SSGE_texture.h"
+#include "SSGE/SSGE_atlas.h"
+#include "SSGE/SSGE_camera.h"
+#include "SSGE/SSGE_layer.h"
+#include "SSGE/SSGE_profiler.h"
+#include "SSGE/SSGE_trace.h"
 #include "SSGE/SSGE_animation.h"
 #include "SSGE/SSGE_tilemap.h"
 #include "SSGE/SSGE_object.h"
@@ -33,6 +39,18 @@ extern "C" {
  */
 SSGEAPI void SSGE_Init(const char *title, uint16_t width, uint16_t height, uint16_t fps);
 
+/**
+ * Initialize the engine with options
+ * \param title The title of the window
+ * \param width The window width, or the size of the offscreen surface
+ * \param height The window height, or the size of the offscreen surface
+ * \param fps The frames per second
+ * \param options The options, NULL for the defaults of `SSGE_Init`
+ * \note Without a renderer (`SSGE_HEADLESS_NORENDER`), textures, text and geometry can't be created and frames are not drawn
+ * \note Without audio, audio can't be loaded
+ */
+SSGEAPI void SSGE_InitEx(const char *title, uint16_t width, uint16_t height, uint16_t fps, const SSGE_InitOptions *options);
+
 /**
  * Quit the engine
  * \note This function must be called at the end of the program
@@ -48,9 +66,45 @@ SSGEAPI void SSGE_Quit();
  * \param data The `void *` to pass to the functions (update, background, draw, eventHandler), can be `NULL`
  * \warning The engine runs in an infinite loop until the window is closed
  * \note The order of execution is as follows: Event handling, Update, (Clear screen), (Object Rendering), Draw
+ * \note `update` runs at a fixed rate of `fps` updates per second, several times in a frame to catch up if needed (up to the max frameskip)
  */
 SSGEAPI void SSGE_Run(SSGE_UpdateFunc update, SSGE_DrawFunc background, SSGE_DrawFunc draw, SSGE_EventHandler eventHandler, void *data);
 
+/**
+ * Get the interpolation factor between the last update and the next one
+ * \return The part of the next update already elapsed when the frame is drawn, from 0 to 1
+ * \note Updates run at a fixed rate, draw functions can blend the previous and current states by this factor for smooth motion
+ */
+SSGEAPI double SSGE_GetInterpolation();
+
+/**
+ * Run a single frame of the engine, without waiting
+ * \param dt The time elapsed since the previous step, in milliseconds
+ * \param present False to draw the frame without presenting it to the window
+ * \param update The update function, can be `NULL`
+ * \param background The function to draw the background, can be `NULL`
+ * \param draw The draw function, can be `NULL`
+ * \param eventHandler The event handler function, can be `NULL`
+ * \param data The `void *` to pass to the functions (update, background, draw, eventHandler), can be `NULL`
+ * \return False if the window was closed during the step
+ * \note The pending events are handled, then `update` is called once per `1000 / fps` ms of accumulated `dt`, then the frame is drawn once
+ * \note The same sequence of `dt` always runs the same updates, which makes runs reproducible
+ */
+SSGEAPI bool SSGE_Step(double dt, bool present, SSGE_UpdateFunc update, SSGE_DrawFunc background, SSGE_DrawFunc draw, SSGE_EventHandler eventHandler, void *data);
+
+/**
+ * Run a number of frames of the engine as fast as possible
+ * \param count The number of frames to run
+ * \param update The update function, can be `NULL`
+ * \param background The function to draw the background, can be `NULL`
+ * \param draw The draw function, can be `NULL`
+ * \param eventHandler The event handler function, can be `NULL`
+ * \param data The `void *` to pass to the functions (update, background, draw, eventHandler), can be `NULL`
+ * \return The number of frames run, lower than `count` if the window was closed
+ * \note Each frame is a `SSGE_Step` of `1000 / fps` ms, running exactly one update
+ */
+SSGEAPI uint32_t SSGE_RunFrames(uint32_t count, SSGE_UpdateFunc update, SSGE_DrawFunc background, SSGE_DrawFunc draw, SSGE_EventHandler eventHandler, void *data);
+
 // Window functions
 
 /**
@@ -113,12 +167,59 @@ SSGEAPI void SSGE_SetManualUpdate(bool manualUpdate);
  */
 SSGEAPI void SSGE_ManualUpdate();
 
+/**
+ * Request the redraw of a region of the window in the partial redraw mode
+ * \param x The x coordinate of the region
+ * \param y The y coordinate of the region
+ * \param width The width of the region
+ * \param height The height of the region
+ * \note Use it when what the `background` or `draw` callbacks draw in the region changes
+ * \note It does nothing if the partial redraw mode is disabled
+ */
+SSGEAPI void SSGE_ManualUpdateRect(int x, int y, int width, int height);
+
+/**
+ * Enable or disable the idle mode
+ * \param idle True if the engine should sleep while nothing happens, false otherwise
+ * \note In the idle mode, `SSGE_Run` blocks until an event arrives when no redraw is requested and no animation plays,
+ * with the manual update mode or the partial redraw mode. A single update then runs before the frame is drawn
+ * \note Use `SSGE_WakeAfter` to wake up the engine without event, for a timer for example
+ * \note While the window is minimized or hidden, the frames are not drawn and the engine runs at 10 frames per second, in any mode
+ */
+SSGEAPI void SSGE_SetIdleMode(bool idle);
+
+/**
+ * Wake up the idle engine after a delay
+ * \param ms The delay in milliseconds
+ * \note Only the earliest pending wake up is kept
+ */
+SSGEAPI void SSGE_WakeAfter(uint32_t ms);
+
+/**
+ * Enable or disable the partial redraw mode
+ * \param partialRedraw True if the partial redraw mode should be enabled, false otherwise
+ * \note In the partial redraw mode, the frame is drawn in a persistent backbuffer and only the regions changed by
+ * object moves, show/hide, texture draws and animation frames are redrawn, in a single pass clipped to their bounding box.
+ * The `background` and `draw` callbacks run once in this pass. Nothing is drawn if nothing changed
+ * \note The manual update mode is ignored while the partial redraw mode is enabled, `SSGE_ManualUpdate` redraws the whole window
+ */
+SSGEAPI void SSGE_SetPartialRedraw(bool partialRedraw);
+
 /**
  * Change the background color
  * \param color The color to set
  */
 SSGEAPI void SSGE_SetBackgroundColor(SSGE_Color color);
 
+/**
+ * Set the layer of the next draws
+ * \param layer The layer, lower layers are drawn first
+ * \param depth The depth in the layer, lower depths are drawn first
+ * \note Applies to the textures drawn, the animations played and the objects created afterwards
+ * \note Textures and animations are sorted by layer, depth then texture each frame, before the `draw` callback
+ */
+SSGEAPI void SSGE_SetDrawLayer(int16_t layer, uint16_t depth);
+
 /**
  * Get the mouse position
  * \param x The variable to store the x coordinate of the mouse
@@ -170,6 +271,36 @@ SSGEAPI uint8_t SSGE_GetMaxFrameskip();
  */
 SSGEAPI bool SSGE_GetVSync();
 
+/**
+ * Allocate temporary memory for the current frame
+ * \param size The number of bytes to allocate
+ * \return The pointer to the memory, aligned for any type
+ * \note The memory is freed all at once at the end of the frame, it must not be freed manually
+ */
+SSGEAPI void *SSGE_FrameAlloc(size_t size);
+
+/**
+ * Get the highest number of bytes allocated from the frame arena during a frame
+ * \return The high-water mark of the frame arena
+ * \note Use it to tune the frame arena size with `SSGE_SetFrameArenaSize`, the unused ends of the blocks the
+ * frame spilled out of are counted so a single block of this size fits the frame
+ */
+SSGEAPI size_t SSGE_GetFrameArenaHighWater();
+
+/**
+ * Set the size of the frame arena
+ * \param size The size in bytes of the frame arena
+ * \note The arena grows if a frame needs more memory, this only avoids the growth during the first frames
+ * \warning Must not be called while memory allocated with `SSGE_FrameAlloc` is in use
+ */
+SSGEAPI void SSGE_SetFrameArenaSize(size_t size);
+
+/**
+ * Get the engine statistics
+ * \param stats Where to store the statistics
+ */
+SSGEAPI void SSGE_GetStats(SSGE_Stats *stats);
+
 // For advanced usage
 /**
  * Get the SDL_Renderer used by the engine
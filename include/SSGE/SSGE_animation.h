@@ -19,6 +19,20 @@ extern "C" {
  */
 SSGEAPI SSGE_Animation *SSGE_Animation_CreateFrames(uint32_t *id, const char *name, uint32_t frameCount, uint16_t width, uint16_t height);
 
+/**
+ * Create an animation with frames cut from a tilemap
+ * \param id Where to store the id of the animation
+ * \param name The name of the animation, can be NULL
+ * \param tilemap The tilemap used as sprite sheet
+ * \param row The row of the first frame
+ * \param col The column of the first frame
+ * \param frameCount The number of frames, taken from the next tiles of the row then from the next rows
+ * \param duration The duration of each frame in microseconds
+ * \return The animation
+ * \note The frames are not copied, the tilemap must not be destroyed before the animation
+ */
+SSGEAPI SSGE_Animation *SSGE_Animation_CreateSheet(uint32_t *id, const char *name, SSGE_Tilemap *tilemap, uint16_t row, uint16_t col, uint32_t frameCount, uint32_t duration);
+
 /**
  * Create an animation with a draw function
  * \param id Where to store the id of the animation
@@ -41,25 +55,53 @@ SSGEAPI void SSGE_Animation_Anchor(SSGE_Animation *animation, int x, int y);
 /**
  * Add a frame to an animation
  * \param animation The animation to add the frame to
- * \param frametime The duration of the frame
+ * \param frametime The duration of the frame, in frames at the current frame rate of the engine (the frame is shown during `frametime + 1` frames)
  * \param file The path to the frame
  * \note This only works for animation with frames
  * \note Using this function on an animation with a function will throw an error
+ * \note The duration is converted into microseconds when the frame is added, changing the frame rate later does not change it
  */
 SSGEAPI void SSGE_Animation_AddFrame(SSGE_Animation *animation, uint8_t frametime, const char *filename);
 
 /**
  * Add a frame from a tilemap to an animation
  * \param animation The animation to add the frame to
- * \param frametime The duration of the frame
+ * \param frametime The duration of the frame, in frames at the current frame rate of the engine (the frame is shown during `frametime + 1` frames)
  * \param tilemap The tilemap to get the tile used as frame from
  * \param row The row of the tile
  * \param col The column of the tile
+ * \note The tile is copied into a texture of its own, `SSGE_Animation_AddFrameSheet` avoids the copy
  * \note This only works for animation with frames
  * \note Using this function on an animation with a function will throw an error
+ * \note The duration is converted into microseconds when the frame is added, changing the frame rate later does not change it
  */
 SSGEAPI void SSGE_Animation_AddFrameTilemap(SSGE_Animation *animation, uint8_t frametime, SSGE_Tilemap *tilemap, int row, int col);
 
+/**
+ * Add a frame from a sprite sheet to an animation, without copying it
+ * \param animation The animation to add the frame to
+ * \param duration The duration of the frame in microseconds
+ * \param tilemap The tilemap used as sprite sheet
+ * \param row The row of the tile
+ * \param col The column of the tile
+ * \note The frames cut from the same sheet are drawn as a single batch, an animation can only use one sheet
+ * \note The tilemap must not be destroyed before the animation
+ * \note This only works for animation with frames
+ * \note Using this function on an animation with a function will throw an error
+ */
+SSGEAPI void SSGE_Animation_AddFrameSheet(SSGE_Animation *animation, uint32_t duration, SSGE_Tilemap *tilemap, uint16_t row, uint16_t col);
+
+/**
+ * Set the duration of a frame of an animation
+ * \param animation The animation
+ * \param frame The index of the frame
+ * \param duration The duration of the frame in microseconds
+ * \note Animations advance with the elapsed time, whatever the frame rate, and even when they are not visible
+ * \note This only works for animation with frames
+ * \note Using this function on an animation with a function will throw an error
+ */
+SSGEAPI void SSGE_Animation_SetFrameDuration(SSGE_Animation *animation, uint32_t frame, uint32_t duration);
+
 /**
  * Get an animation
  * \param id The id of the animation
@@ -83,9 +125,50 @@ SSGEAPI SSGE_Animation *SSGE_Animation_GetName(const char *name);
  * \param reversed If the animation should be reversed
  * \param pingpong If the animation should pingpong (normal -> reversed)
  * \return The id of the animation state bound to the animation
+ * \note The animation is drawn on the layer set by `SSGE_SetDrawLayer`
  */
 SSGEAPI uint32_t SSGE_Animation_Play(SSGE_Animation *animation, int x, int y, uint32_t loop, bool reversed, bool pingpong);
 
+/**
+ * Play an animation on a clock shared by many instances
+ * \param animation The animation to play
+ * \param loop The number of time the animation should be played (0 means once, -1 means indefinitly)
+ * \param reversed If the animation should be reversed
+ * \param pingpong If the animation should pingpong (normal -> reversed)
+ * \return The id of the animation state bound to the animation
+ * \note The frame is chosen once for all the instances, which are drawn together, see `SSGE_Animation_AddInstance`
+ * \note The animation state can be paused, resumed, stopped and moved to another layer like any other
+ * \note This only works for animation with frames
+ */
+SSGEAPI uint32_t SSGE_Animation_PlayShared(SSGE_Animation *animation, uint32_t loop, bool reversed, bool pingpong);
+
+/**
+ * Add an instance to a shared animation
+ * \param id The id of the animation state returned by `SSGE_Animation_PlayShared`
+ * \param x The x coordinate of the instance
+ * \param y The y coordinate of the instance
+ * \param phase The number of frames the instance is ahead of the others
+ * \return The id of the instance
+ * \note The instances are removed when the animation state stops
+ */
+SSGEAPI uint32_t SSGE_Animation_AddInstance(uint32_t id, int x, int y, uint32_t phase);
+
+/**
+ * Move an instance of a shared animation
+ * \param id The id of the animation state
+ * \param instance The id of the instance
+ * \param x The x coordinate of the instance
+ * \param y The y coordinate of the instance
+ */
+SSGEAPI void SSGE_Animation_MoveInstance(uint32_t id, uint32_t instance, int x, int y);
+
+/**
+ * Remove an instance of a shared animation
+ * \param id The id of the animation state
+ * \param instance The id of the instance
+ */
+SSGEAPI void SSGE_Animation_RemoveInstance(uint32_t id, uint32_t instance);
+
 /**
  * Pause an animation
  * \param id The id of the animation state bound to the animation to pause
@@ -110,6 +193,14 @@ SSGEAPI void SSGE_Animation_Stop(uint32_t id);
  */
 SSGEAPI void SSGE_Animation_Move(uint32_t id, int x, int y);
 
+/**
+ * Set the layer of an animation
+ * \param id The id of the animation state bound to the animation
+ * \param layer The layer, lower layers are drawn first
+ * \param depth The depth in the layer, lower depths are drawn first
+ */
+SSGEAPI void SSGE_Animation_SetLayer(uint32_t id, int16_t layer, uint16_t depth);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,69 @@
+#ifndef __SSGE_ATLAS_H__
+#define __SSGE_ATLAS_H__
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE/SSGE_types.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create a texture atlas
+ * \param pageWidth The width of the pages of the atlas
+ * \param pageHeight The height of the pages of the atlas
+ * \return The atlas
+ * \note Textures are added to the atlas, then packed into pages by `SSGE_Atlas_Build`
+ * \note The atlas is freed with its last texture, or by `SSGE_Atlas_Build` if it has no texture
+ */
+SSGEAPI SSGE_Atlas *SSGE_Atlas_Create(uint16_t pageWidth, uint16_t pageHeight);
+
+/**
+ * Load an image into an atlas
+ * \param atlas The atlas
+ * \param id Where to store the id of the texture
+ * \param name The name of the texture, can be NULL
+ * \param filename The path to the image
+ * \return The texture
+ * \note The texture can be used before the atlas is built
+ * \note The images are packed on pages of their own, which are static textures
+ */
+SSGEAPI SSGE_Texture *SSGE_Atlas_AddImage(SSGE_Atlas *atlas, uint32_t *id, const char *name, const char *filename);
+
+/**
+ * Add a tile of a tilemap to an atlas
+ * \param atlas The atlas
+ * \param id Where to store the id of the texture
+ * \param name The name of the texture, can be NULL
+ * \param tilemap The tilemap
+ * \param row The row of the tile
+ * \param col The column of the tile
+ * \return The texture
+ * \note The tilemap must not be destroyed before the atlas is built
+ */
+SSGEAPI SSGE_Texture *SSGE_Atlas_AddTile(SSGE_Atlas *atlas, uint32_t *id, const char *name, SSGE_Tilemap *tilemap, uint16_t row, uint16_t col);
+
+/**
+ * Move an existing texture into an atlas
+ * \param atlas The atlas
+ * \param texture The texture, for example one created by the geometry functions
+ * \note The SDL_Texture of the texture is destroyed when the atlas is built
+ */
+SSGEAPI void SSGE_Atlas_AddTexture(SSGE_Atlas *atlas, SSGE_Texture *texture);
+
+/**
+ * Pack the textures of an atlas into its pages
+ * \param atlas The atlas
+ * \note Textures larger than a page get a page of their own
+ * \note Once built, the textures of an atlas are drawn together, page by page
+ * \note The tiles and the moved textures are copied to render target pages, which lose their content like the
+ * geometry textures if the render targets are reset, for example when a Direct3D 9 window is resized
+ */
+SSGEAPI void SSGE_Atlas_Build(SSGE_Atlas *atlas);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_ATLAS_H__
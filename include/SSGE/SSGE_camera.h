@@ -0,0 +1,78 @@
+#ifndef __SSGE_CAMERA_H__
+#define __SSGE_CAMERA_H__
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE/SSGE_types.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Set the position of the camera
+ * \param x The x coordinate of the world point shown at the top-left corner of the viewport
+ * \param y The y coordinate of the world point shown at the top-left corner of the viewport
+ * \note The camera applies to textures, objects, frame animations and tilemap tiles, which are placed in world coordinates
+ * \note Geometry, text and the `draw` callbacks stay in window coordinates
+ */
+SSGEAPI void SSGE_Camera_SetPosition(int x, int y);
+
+/**
+ * Move the camera relatively to its position
+ * \param dx The x offset
+ * \param dy The y offset
+ */
+SSGEAPI void SSGE_Camera_Move(int dx, int dy);
+
+/**
+ * Set the zoom of the camera
+ * \param zoom The zoom, 1 shows the world at its size, 2 shows it twice as large
+ */
+SSGEAPI void SSGE_Camera_SetZoom(float zoom);
+
+/**
+ * Set the region of the window the camera draws in
+ * \param x The x coordinate of the viewport in the window
+ * \param y The y coordinate of the viewport in the window
+ * \param width The width of the viewport, 0 for the whole window
+ * \param height The height of the viewport, 0 for the whole window
+ */
+SSGEAPI void SSGE_Camera_SetViewport(int x, int y, int width, int height);
+
+/**
+ * Get the position of the camera
+ * \param x Where to store the x coordinate, can be NULL
+ * \param y Where to store the y coordinate, can be NULL
+ */
+SSGEAPI void SSGE_Camera_GetPosition(int *x, int *y);
+
+/**
+ * Get the zoom of the camera
+ * \return The zoom
+ */
+SSGEAPI float SSGE_Camera_GetZoom();
+
+/**
+ * Convert window coordinates to world coordinates
+ * \param x The x coordinate in the window
+ * \param y The y coordinate in the window
+ * \param worldX Where to store the x coordinate in the world
+ * \param worldY Where to store the y coordinate in the world
+ */
+SSGEAPI void SSGE_Camera_ScreenToWorld(int x, int y, int *worldX, int *worldY);
+
+/**
+ * Convert world coordinates to window coordinates
+ * \param x The x coordinate in the world
+ * \param y The y coordinate in the world
+ * \param screenX Where to store the x coordinate in the window
+ * \param screenY Where to store the y coordinate in the window
+ */
+SSGEAPI void SSGE_Camera_WorldToScreen(int x, int y, int *screenX, int *screenY);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_CAMERA_H__
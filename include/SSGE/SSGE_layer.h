@@ -0,0 +1,34 @@
+#ifndef __SSGE_LAYER_H__
+#define __SSGE_LAYER_H__
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE/SSGE_types.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Mark a layer as static or dynamic
+ * \param layer The layer, as set by `SSGE_SetDrawLayer`
+ * \param isStatic True to cache the layer, false to draw it every frame again
+ * \note The object sprites of a static layer are drawn once into a texture, which is then drawn each frame with a single copy
+ * \note The cache is redrawn when a sprite of the layer changes, when the camera changes or after `SSGE_Layer_Invalidate`
+ * \note Textures drawn with `SSGE_Texture_Draw` and animations on a static layer are not cached, they are drawn above the cache
+ * \note At most 8 layers can be static
+ */
+SSGEAPI void SSGE_Layer_SetStatic(int16_t layer, bool isStatic);
+
+/**
+ * Redraw the cache of a static layer on the next frame
+ * \param layer The layer
+ * \note Needed only when the content of a texture drawn on the layer changes
+ */
+SSGEAPI void SSGE_Layer_Invalidate(int16_t layer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_LAYER_H__
@@ -33,6 +33,16 @@ SSGEAPI SSGE_Object *SSGE_Object_Create(uint32_t *id, const char *name, int x, i
  */
 SSGEAPI SSGE_Object *SSGE_Object_Instantiate(uint32_t *id, SSGE_ObjectTemplate *template, char *name, int x, int y);
 
+/**
+ * Instantiate several unnamed objects from an object template at once
+ * \param template The object template to instantiate
+ * \param count The number of objects to instantiate
+ * \param positions The positions of the objects, `count` points
+ * \param ids Where to store the ids of the objects, `count` ids
+ * \note Faster than instantiating the objects one by one, the internal storage grows only once
+ */
+SSGEAPI void SSGE_Object_InstantiateBatch(SSGE_ObjectTemplate *template, uint32_t count, const SSGE_Point *positions, uint32_t *ids);
+
 /**
  * Check if an object exists
  * \param id The id of the object
@@ -93,11 +103,29 @@ SSGEAPI void SSGE_Object_BindTexture(SSGE_Object *object, SSGE_Texture *texture)
  */
 SSGEAPI void SSGE_Object_BindAnimation(SSGE_Object *object, SSGE_Animation *animation, bool reversed, bool pingpong);
 
+/**
+ * Bind a shared animation to an object
+ * \param object The object to bind the animation to
+ * \param id The id of the animation state returned by `SSGE_Animation_PlayShared`
+ * \param phase The number of frames the object is ahead of the other instances
+ * \note The object is drawn on the layer of the shared animation state
+ */
+SSGEAPI void SSGE_Object_BindSharedAnimation(SSGE_Object *object, uint32_t id, uint32_t phase);
+
 /**
  * Remove the texure of an object
  * \param object The object to remove the texture of
  */
 SSGEAPI void SSGE_Object_RemoveSprite(SSGE_Object *object);
+
+/**
+ * Set the layer of the sprite of an object
+ * \param object The object
+ * \param layer The layer, lower layers are drawn first
+ * \param depth The depth in the layer, lower depths are drawn first
+ * \note Objects are created on the layer set by `SSGE_SetDrawLayer`
+ */
+SSGEAPI void SSGE_Object_SetLayer(SSGE_Object *object, int16_t layer, uint16_t depth);
 #define SSGE_Object_RemoveTexture SSGE_Object_RemoveSprite
 #define SSGE_Object_RemoveAnim SSGE_Object_RemoveSprite
 
@@ -147,6 +175,13 @@ SSGEAPI void SSGE_Object_Resize(SSGE_Object *object, uint16_t width, uint16_t he
  */
 SSGEAPI void SSGE_Object_Destroy(uint32_t id);
 
+/**
+ * Destroy several objects by id
+ * \param ids The ids of the objects
+ * \param count The number of objects to destroy
+ */
+SSGEAPI void SSGE_Object_DestroyBatch(const uint32_t *ids, uint32_t count);
+
 /**
  * Destroy all objects with a given name
  * \param name The name of the object
@@ -175,30 +210,32 @@ SSGEAPI bool SSGE_Object_IsHovered(SSGE_Object *object);
 
 /**
  * Get the object at a coordinate
- * \param x The x coordinate to check
- * \param y The y coordinate to check
+ * \param x The x coordinate to check, in the world
+ * \param y The y coordinate to check, in the world
  * \return The object at the coordinate, NULL if no object is at the coordinate
  * \note An object is considered at a certain coordinate if at least one pixel is at that said coordinate.
  * \note Meaning that it doesn't need to be exactly at that coordinate (doesn't need `object.x == x && object.y == y`).
- * \warning If multiple objects are detected, returns the object with the smallest id
+ * \note Window coordinates, like the `x` and `y` of a mouse event, must first be converted with `SSGE_Camera_ScreenToWorld`
+ * \warning If multiple objects are detected, returns the first one found
  */
 SSGEAPI SSGE_Object *SSGE_Object_GetAt(int x, int y);
 
 /**
  * Get the list of objects at a coordinate
- * \param x The x coordinate to check
- * \param y The y coordinate to check
+ * \param x The x coordinate to check, in the world
+ * \param y The y coordinate to check, in the world
  * \return The object at the coordinate, NULL if no object is at the coordinate
  * \note An object is considered at a certain coordinate if at least one pixel is at that said coordinate.
  * \note Meaning that it doesn't need to be exactly at that coordinate (doesn't need `object.x == x && object.y == y`).
+ * \note Window coordinates, like the `x` and `y` of a mouse event, must first be converted with `SSGE_Camera_ScreenToWorld`
  */
 SSGEAPI uint32_t SSGE_Object_GetAtList(int x, int y, SSGE_Object *objects[], uint32_t size);
 
 /**
  * Get the hovered object
  * \return The hovered object, NULL if no object is hovered
- * \warning If multiple objects are hovered, returns the hovered object with the smallest id
- * \warning It is not recommended to use this to get object at click position, use the event `x` and `y` with the `SSGE_Object_GetAt` function.
+ * \warning If multiple objects are hovered, returns the first one found
+ * \warning It is not recommended to use this to get object at click position, convert the event `x` and `y` with `SSGE_Camera_ScreenToWorld` and use the `SSGE_Object_GetAt` function.
  */
 SSGEAPI SSGE_Object *SSGE_Object_GetHovered();
 
@@ -207,7 +244,7 @@ SSGEAPI SSGE_Object *SSGE_Object_GetHovered();
  * \param objects The array to store the hovered objects
  * \param size The size of the array
  * \return The number of objects retrieved
- * \warning It is not recommended to use this to get object at click position, use the event `x` and `y` with the `SSGE_Object_GetAtList` function.
+ * \warning It is not recommended to use this to get object at click position, convert the event `x` and `y` with `SSGE_Camera_ScreenToWorld` and use the `SSGE_Object_GetAtList` function.
  */
 SSGEAPI uint32_t SSGE_Objects_GetHoveredList(SSGE_Object *objects[], uint32_t size);
 
@@ -0,0 +1,39 @@
+#ifndef __SSGE_PROFILER_H__
+#define __SSGE_PROFILER_H__
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE/SSGE_types.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Enable or disable the frame profiler
+ * \param enabled True to record the time spent in each phase of the frames
+ * \note The last 120 frames are kept, enabling the profiler again starts a new recording
+ */
+SSGEAPI void SSGE_Profiler_Enable(bool enabled);
+
+/**
+ * Get the statistics of a phase over the recorded frames
+ * \param phase The phase
+ * \param stats Where to store the statistics, in milliseconds
+ * \return False if no frame is recorded yet
+ */
+SSGEAPI bool SSGE_Profiler_GetStats(SSGE_ProfilePhase phase, SSGE_PhaseStats *stats);
+
+/**
+ * Show or hide the profiler overlay
+ * \param show True to draw the frame time graph and the phase statistics in the top-left corner of the window
+ * \note Showing the overlay enables the profiler, the overlay itself is not profiled
+ * \note In partial redraw mode, the overlay is only updated with the damaged regions
+ */
+SSGEAPI void SSGE_Profiler_ShowOverlay(bool show);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_PROFILER_H__
@@ -48,6 +48,7 @@ SSGEAPI void SSGE_Texture_Anchor(SSGE_Texture *texture, int x, int y);
  * \param y The y coordinate at which the texture is drawn
  * \param width The width of the texture
  * \param height The height of the texture
+ * \note The texture is drawn on the layer set by `SSGE_SetDrawLayer`
  */
 SSGEAPI void SSGE_Texture_Draw(SSGE_Texture *texture, int x, int y, int width, int height);
 
@@ -61,6 +62,7 @@ SSGEAPI void SSGE_Texture_Draw(SSGE_Texture *texture, int x, int y, int width, i
  * \param angle The angle in degrees to rotate the texture (clockwise rotation)
  * \param center The center of the rotation
  * \param flip The flip to apply to the texture
+ * \note The texture is drawn on the layer set by `SSGE_SetDrawLayer`
  */
 SSGEAPI void SSGE_Texture_DrawEx(SSGE_Texture *texture, int x, int y, int width, int height, double angle, SSGE_Point center, SSGE_Flip flip);
 
@@ -0,0 +1,49 @@
+#ifndef __SSGE_TRACE_H__
+#define __SSGE_TRACE_H__
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE/SSGE_types.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Start recording a trace
+ * \param filename The path of the trace file, in Chrome trace-event JSON (chrome://tracing, Perfetto)
+ * \note The phases of the frames, asset loads, text rendering and geometry baking are recorded, with the user zones
+ */
+SSGEAPI void SSGE_Trace_Start(const char *filename);
+
+/**
+ * Write the zones recorded so far to the trace file
+ * \note Can be called while other threads record zones, the zones they close meanwhile are written by the next flush
+ */
+SSGEAPI void SSGE_Trace_Flush();
+
+/**
+ * Stop recording the trace, writing the remaining zones and closing the file
+ * \note Called by `SSGE_Quit` if a trace is recording
+ * \note Must not be called while other threads record zones, their buffers are freed
+ */
+SSGEAPI void SSGE_Trace_Stop();
+
+/**
+ * Open a zone of the trace
+ * \param name The name of the zone, must stay valid until the trace is flushed (a string literal for example)
+ * \note Zones are recorded per thread, without locking
+ * \note Every zone must be closed by `SSGE_Trace_End` on the same thread
+ */
+SSGEAPI void SSGE_Trace_Begin(const char *name);
+
+/**
+ * Close the last zone opened by the thread
+ */
+SSGEAPI void SSGE_Trace_End();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_TRACE_H__
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stddef.h>
 
 #include "SSGE/SSGE_config.h"
 #include "SSGE/SSGE_events.h"
@@ -64,7 +65,8 @@ typedef enum _SSGE_AnimationType {
 typedef enum _SSGE_SpriteType {
     SSGE_SPRITE_NONE = -1U, // No sprite
     SSGE_SPRITE_STATIC = 0, // Single frame sprite
-    SSGE_SPRITE_ANIM        // Animated sprite
+    SSGE_SPRITE_ANIM,       // Animated sprite
+    SSGE_SPRITE_SHARED      // Instance of a shared animation
 } SSGE_SpriteType;
 
 typedef enum _SSGE_Anchor {
@@ -79,8 +81,54 @@ typedef enum _SSGE_Anchor {
     SSGE_SE
 } SSGE_Anchor;
 
+// Engine statistics struct
+typedef struct _SSGE_Stats {
+    size_t      frameArenaHighWater;    // The highest number of bytes allocated from the frame arena during a frame
+    size_t      internedBytes;          // The number of bytes used by the interned resource names
+    uint32_t    internedNames;          // The number of distinct resource names
+} SSGE_Stats;
+
+typedef enum _SSGE_ProfilePhase {
+    SSGE_PHASE_EVENTS,      // Event polling and the event handler
+    SSGE_PHASE_UPDATE,      // The update loops
+    SSGE_PHASE_CLEAR,       // Clearing the window
+    SSGE_PHASE_BACKGROUND,  // The `background` callback
+    SSGE_PHASE_TEXTURES,    // Building the render commands of the textures
+    SSGE_PHASE_ANIMATIONS,  // Building the render commands of the animations
+    SSGE_PHASE_SUBMIT,      // Sorting and submitting the render commands, function animations
+    SSGE_PHASE_DRAW,        // The `draw` callback
+    SSGE_PHASE_PRESENT,     // Presenting the frame
+    SSGE_PHASE_FRAME,       // The whole frame, without the wait for the next one
+    SSGE_PHASE_COUNT
+} SSGE_ProfilePhase;
+
+// Profiler statistics struct, in milliseconds over the recorded frames
+typedef struct _SSGE_PhaseStats {
+    double      min;    // The shortest time
+    double      avg;    // The average time
+    double      p99;    // The 99th percentile
+} SSGE_PhaseStats;
+
+typedef enum _SSGE_HeadlessMode {
+    SSGE_HEADLESS_OFF,          // A window with an accelerated renderer
+    SSGE_HEADLESS_DUMMY,        // A window on the dummy video driver, drawn by the software renderer
+    SSGE_HEADLESS_OFFSCREEN,    // No window, a software renderer drawing into an offscreen surface
+    SSGE_HEADLESS_NORENDER      // No window and no renderer, nothing is drawn
+} SSGE_HeadlessMode;
+
+// Engine initialization options struct, zero fields keep their default
+typedef struct _SSGE_InitOptions {
+    SSGE_HeadlessMode   headless;           // The headless mode, defaults to `SSGE_HEADLESS_OFF`
+    bool                noAudio;            // If the audio mixer is not initialized
+    uint32_t            textureCapacity;    // The initial capacity of the texture registry
+    uint32_t            objectCapacity;     // The initial capacity of the object registry
+    uint32_t            animationCapacity;  // The initial capacity of the animation registry
+    uint32_t            playingCapacity;    // The initial capacity of the playing animation registry
+} SSGE_InitOptions;
+
 typedef struct _SSGE_Engine         SSGE_Engine;
 typedef struct _SSGE_Texture        SSGE_Texture;
+typedef struct _SSGE_Atlas          SSGE_Atlas;
 typedef struct _SSGE_Object         SSGE_Object;
 typedef struct _SSGE_ObjectTemplate SSGE_ObjectTemplate;
 
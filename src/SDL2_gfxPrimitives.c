@@ -36,6 +36,17 @@ Andreas Schiffler -- aschiffler at ferzkopp dot net
 #include "SDL2_rotozoom.h"
 #include "SDL2_gfxPrimitives_font.h"
 
+#ifdef SSGE_BUILD
+#include "SSGE_local.h"
+
+/* Temporary buffers are taken from the engine frame arena */
+#define GFX_TEMP_ALLOC(size) SSGE_Arena_Alloc(&_frameArena, (size))
+#define GFX_TEMP_FREE(ptr) SSGE_Arena_Rewind(&_frameArena, (ptr))
+#else
+#define GFX_TEMP_ALLOC(size) malloc(size)
+#define GFX_TEMP_FREE(ptr) free(ptr)
+#endif
+
 /* ---- Structures */
 
 /*!
@@ -2306,7 +2317,7 @@ int _pieRGBA(SDL_Renderer *renderer, Sint16 x, Sint16 y, Sint16 rad, Sint16 star
 	}
 
 	/* Allocate combined vertex array */
-	vx = vy = (Sint16 *)malloc(2 * sizeof(Uint16) * numpoints);
+	vx = vy = (Sint16 *)GFX_TEMP_ALLOC(2 * sizeof(Uint16) * numpoints);
 	if (vx == NULL)
 	{
 		return (-1);
@@ -2357,7 +2368,7 @@ int _pieRGBA(SDL_Renderer *renderer, Sint16 x, Sint16 y, Sint16 rad, Sint16 star
 	}
 
 	/* Free combined vertex array */
-	free(vx);
+	GFX_TEMP_FREE(vx);
 
 	return (result);
 }
@@ -2707,7 +2718,7 @@ int polygon(SDL_Renderer *renderer, const Sint16 *vx, const Sint16 *vy, int n)
 	 * Create array of points
 	 */
 	nn = n + 1;
-	points = (SDL_Point *)malloc(sizeof(SDL_Point) * nn);
+	points = (SDL_Point *)GFX_TEMP_ALLOC(sizeof(SDL_Point) * nn);
 	if (points == NULL)
 	{
 		return -1;
@@ -2724,7 +2735,7 @@ int polygon(SDL_Renderer *renderer, const Sint16 *vx, const Sint16 *vy, int n)
 	 * Draw
 	 */
 	result |= SDL_RenderDrawLines(renderer, points, nn);
-	free(points);
+	GFX_TEMP_FREE(points);
 
 	return (result);
 }
@@ -2890,6 +2901,7 @@ int _gfxPrimitivesCompareInt(const void *a, const void *b)
 
 Note: Used for non-multithreaded (default) operation of filledPolygonMT.
 */
+#ifndef SSGE_BUILD
 static int *gfxPrimitivesPolyIntsGlobal = NULL;
 
 /*!
@@ -2898,6 +2910,7 @@ static int *gfxPrimitivesPolyIntsGlobal = NULL;
 Note: Used for non-multithreaded (default) operation of filledPolygonMT.
 */
 static int gfxPrimitivesPolyAllocatedGlobal = 0;
+#endif
 
 /*!
 \brief Draw filled polygon with alpha blending (multi-threaded capable).
@@ -2956,9 +2969,15 @@ int filledPolygonRGBAMT(SDL_Renderer *renderer, const Sint16 *vx, const Sint16 *
 	 */
 	if ((polyInts == NULL) || (polyAllocated == NULL))
 	{
+#ifdef SSGE_BUILD
+		/* Use frame arena */
+		gfxPrimitivesPolyInts = (int *)GFX_TEMP_ALLOC(sizeof(int) * n);
+		gfxPrimitivesPolyAllocated = n;
+#else
 		/* Use global cache */
 		gfxPrimitivesPolyInts = gfxPrimitivesPolyIntsGlobal;
 		gfxPrimitivesPolyAllocated = gfxPrimitivesPolyAllocatedGlobal;
+#endif
 	}
 	else
 	{
@@ -3010,8 +3029,10 @@ int filledPolygonRGBAMT(SDL_Renderer *renderer, const Sint16 *vx, const Sint16 *
 	 */
 	if ((polyInts == NULL) || (polyAllocated == NULL))
 	{
+#ifndef SSGE_BUILD
 		gfxPrimitivesPolyIntsGlobal = gfxPrimitivesPolyInts;
 		gfxPrimitivesPolyAllocatedGlobal = gfxPrimitivesPolyAllocated;
+#endif
 	}
 	else
 	{
@@ -3106,6 +3127,13 @@ int filledPolygonRGBAMT(SDL_Renderer *renderer, const Sint16 *vx, const Sint16 *
 		}
 	}
 
+#ifdef SSGE_BUILD
+	if ((polyInts == NULL) || (polyAllocated == NULL))
+	{
+		GFX_TEMP_FREE(gfxPrimitivesPolyInts);
+	}
+#endif
+
 	return (result);
 }
 
@@ -3298,9 +3326,15 @@ int texturedPolygonMT(SDL_Renderer *renderer, const Sint16 *vx, const Sint16 *vy
 	 */
 	if ((polyInts == NULL) || (polyAllocated == NULL))
 	{
+#ifdef SSGE_BUILD
+		/* Use frame arena */
+		gfxPrimitivesPolyInts = (int *)GFX_TEMP_ALLOC(sizeof(int) * n);
+		gfxPrimitivesPolyAllocated = n;
+#else
 		/* Use global cache */
 		gfxPrimitivesPolyInts = gfxPrimitivesPolyIntsGlobal;
 		gfxPrimitivesPolyAllocated = gfxPrimitivesPolyAllocatedGlobal;
+#endif
 	}
 	else
 	{
@@ -3345,8 +3379,10 @@ int texturedPolygonMT(SDL_Renderer *renderer, const Sint16 *vx, const Sint16 *vy
 	 */
 	if ((polyInts == NULL) || (polyAllocated == NULL))
 	{
+#ifndef SSGE_BUILD
 		gfxPrimitivesPolyIntsGlobal = gfxPrimitivesPolyInts;
 		gfxPrimitivesPolyAllocatedGlobal = gfxPrimitivesPolyAllocated;
+#endif
 	}
 	else
 	{
@@ -3455,6 +3491,13 @@ int texturedPolygonMT(SDL_Renderer *renderer, const Sint16 *vx, const Sint16 *vy
 	SDL_RenderPresent(renderer);
 	SDL_DestroyTexture(textureAsTexture);
 
+#ifdef SSGE_BUILD
+	if ((polyInts == NULL) || (polyAllocated == NULL))
+	{
+		GFX_TEMP_FREE(gfxPrimitivesPolyInts);
+	}
+#endif
+
 	return (result);
 }
 
@@ -3964,13 +4007,13 @@ int bezierRGBA(SDL_Renderer *renderer, const Sint16 *vx, const Sint16 *vy, int n
 	stepsize = (double)1.0 / (double)s;
 
 	/* Transfer vertices into float arrays */
-	if ((x = (double *)malloc(sizeof(double) * (n + 1))) == NULL)
+	if ((x = (double *)GFX_TEMP_ALLOC(sizeof(double) * (n + 1))) == NULL)
 	{
 		return (-1);
 	}
-	if ((y = (double *)malloc(sizeof(double) * (n + 1))) == NULL)
+	if ((y = (double *)GFX_TEMP_ALLOC(sizeof(double) * (n + 1))) == NULL)
 	{
-		free(x);
+		GFX_TEMP_FREE(x);
 		return (-1);
 	}
 	for (i = 0; i < n; i++)
@@ -4005,8 +4048,8 @@ int bezierRGBA(SDL_Renderer *renderer, const Sint16 *vx, const Sint16 *vy, int n
 	}
 
 	/* Clean up temporary array */
-	free(x);
-	free(y);
+	GFX_TEMP_FREE(y);
+	GFX_TEMP_FREE(x);
 
 	return (result);
 }
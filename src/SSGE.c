@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <math.h>
 
 #include "SSGE/SSGE.h"
 #include "SSGE_local.h"
@@ -25,9 +26,24 @@ static int _eventFilter(void *userdata, SDL_Event *event) {
 }
 
 SSGEAPI void SSGE_Init(const char *title, uint16_t width, uint16_t height, uint16_t fps) {
+    SSGE_InitEx(title, width, height, fps, NULL);
+}
+
+static inline uint32_t _capacity(uint32_t capacity, uint32_t defaultCapacity) {
+    return capacity ? capacity : defaultCapacity;
+}
+
+SSGEAPI void SSGE_InitEx(const char *title, uint16_t width, uint16_t height, uint16_t fps, const SSGE_InitOptions *options) {
+    SSGE_InitOptions defaults = {0};
+    if (options == NULL) options = &defaults;
+
     if (_engine.initialized == true)
         SSGE_Error("Engine already initialized")
 
+    // The dummy driver still provides the event queue and the keyboard state
+    if (options->headless != SSGE_HEADLESS_OFF)
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+
     if (SDL_Init(SDL_INIT_VIDEO) != 0)
         SSGE_ErrorEx("Failed to initialize SDL: %s", SDL_GetError())
 
@@ -38,36 +54,80 @@ SSGEAPI void SSGE_Init(const char *title, uint16_t width, uint16_t height, uint1
         SSGE_Error("title can't be NULL")
     _engine.title = (char *)malloc(strlen(title) + 1);
     strcpy(_engine.title, title);
-    _engine.window = SDL_CreateWindow(title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, 0);
-    if (_engine.window == NULL)
-        SSGE_ErrorEx("Failed to create window: %s", SDL_GetError())
 
-    SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
-    SDL_SetHint(SDL_HINT_VIDEO_DOUBLE_BUFFER, "1");
-    _engine.renderer = SDL_CreateRenderer(_engine.window, -1, SDL_RENDERER_ACCELERATED);
-    if (_engine.renderer == NULL)
-        SSGE_ErrorEx("Failed to create renderer: %s", SDL_GetError())
+    _engine.window = NULL;
+    _engine.renderer = NULL;
+    _engine.offscreen = NULL;
+    _engine.headless = options->headless;
+    switch (options->headless) {
+        case SSGE_HEADLESS_OFF:
+        case SSGE_HEADLESS_DUMMY:
+            _engine.window = SDL_CreateWindow(title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, 0);
+            if (_engine.window == NULL)
+                SSGE_ErrorEx("Failed to create window: %s", SDL_GetError())
+
+            SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+            SDL_SetHint(SDL_HINT_VIDEO_DOUBLE_BUFFER, "1");
+            _engine.renderer = SDL_CreateRenderer(_engine.window, -1, options->headless == SSGE_HEADLESS_OFF ? SDL_RENDERER_ACCELERATED : SDL_RENDERER_SOFTWARE);
+            if (_engine.renderer == NULL)
+                SSGE_ErrorEx("Failed to create renderer: %s", SDL_GetError())
+            break;
+        case SSGE_HEADLESS_OFFSCREEN:
+            _engine.offscreen = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA8888);
+            if (_engine.offscreen == NULL)
+                SSGE_ErrorEx("Failed to create offscreen surface: %s", SDL_GetError())
+
+            _engine.renderer = SDL_CreateSoftwareRenderer(_engine.offscreen);
+            if (_engine.renderer == NULL)
+                SSGE_ErrorEx("Failed to create renderer: %s", SDL_GetError())
+            break;
+        case SSGE_HEADLESS_NORENDER:
+            break;
+    }
 
-    if (SDL_SetRenderDrawBlendMode(_engine.renderer, SDL_BLENDMODE_BLEND) != 0)
-        SSGE_ErrorEx("Failed to set renderer to blend mode: %s", SDL_GetError())
+    if (_engine.renderer != NULL) {
+        if (SDL_SetRenderDrawBlendMode(_engine.renderer, SDL_BLENDMODE_BLEND) != 0)
+            SSGE_ErrorEx("Failed to set renderer to blend mode: %s", SDL_GetError())
 
-    if (Mix_Init(MIX_INIT_MP3 | MIX_INIT_OGG | MIX_INIT_WAVPACK) == 0) 
-        SSGE_ErrorEx("Failed to initialize audio mixer: %s", SDL_GetError())
+        SSGE_SpriteBatch_Create(&_spriteBatch, _engine.renderer);
+        SDL_SetRenderDrawColor(_engine.renderer, 0, 0, 0, 255);
+    }
 
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) != 0) 
-        SSGE_ErrorEx("Failed to open audio device for playback: %s", SDL_GetError())
+    _engine.audio = !options->noAudio;
+    if (_engine.audio) {
+        if (Mix_Init(MIX_INIT_MP3 | MIX_INIT_OGG | MIX_INIT_WAVPACK) == 0) 
+            SSGE_ErrorEx("Failed to initialize audio mixer: %s", SDL_GetError())
 
-    SDL_SetEventFilter(_eventFilter, NULL);
+        if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) != 0) 
+            SSGE_ErrorEx("Failed to open audio device for playback: %s", SDL_GetError())
+    }
 
-    SDL_SetRenderDrawColor(_engine.renderer, 0, 0, 0, 255);
+    SDL_SetEventFilter(_eventFilter, NULL);
 
-    SSGE_Array_Create(&_textureList);
-    SSGE_Array_Create(&_objectList);
-    SSGE_Array_Create(&_objectTemplateList);
-    SSGE_Array_Create(&_fontList);
-    SSGE_Array_Create(&_audioList);
-    SSGE_Array_Create(&_animationList);
-    SSGE_Array_Create(&_playingAnim);
+    SSGE_Pool_Create(&_objectPool, sizeof(SSGE_Object), _POOL_SLAB_BLOCKS);
+    SSGE_Pool_Create(&_animStatePool, sizeof(SSGE_AnimationState), _POOL_SLAB_BLOCKS);
+    SSGE_Pool_Create(&_namePool, _NAME_BLOCK_SIZE, _POOL_SLAB_BLOCKS);
+
+    SSGE_Transforms_Create(&_objectTransforms, _capacity(options->objectCapacity, _TRANSFORMS_INITIAL_SIZE));
+    SSGE_Grid_Create(&_renderGrid);
+
+    // Kept so the registries are recreated with the same capacity when everything is destroyed
+    _engine.textureCapacity = _capacity(options->textureCapacity, _LIST_INITIAL_SIZE);
+    _engine.objectCapacity = _capacity(options->objectCapacity, _LIST_INITIAL_SIZE);
+    SSGE_Array_CreateSlotMap(&_textureList, _engine.textureCapacity);
+    SSGE_Array_CreateSlotMap(&_objectList, _engine.objectCapacity);
+    SSGE_Array_CreateSlotMap(&_objectTemplateList, _LIST_INITIAL_SIZE);
+    SSGE_Array_CreateSlotMap(&_fontList, _LIST_INITIAL_SIZE);
+    SSGE_Array_CreateSlotMap(&_audioList, _LIST_INITIAL_SIZE);
+    SSGE_Array_CreateSlotMap(&_animationList, _capacity(options->animationCapacity, _LIST_INITIAL_SIZE));
+    SSGE_Array_CreateSlotMap(&_playingAnim, _capacity(options->playingCapacity, _PLAYING_ANIM_INITIAL_SIZE));
+
+    SSGE_Array_IndexNames(&_textureList);
+    SSGE_Array_IndexNames(&_objectList);
+    SSGE_Array_IndexNames(&_objectTemplateList);
+    SSGE_Array_IndexNames(&_fontList);
+    SSGE_Array_IndexNames(&_audioList);
+    SSGE_Array_IndexNames(&_animationList);
 
     _engine.icon = NULL;
     _engine.width = width;
@@ -77,180 +137,624 @@ SSGEAPI void SSGE_Init(const char *title, uint16_t width, uint16_t height, uint1
     _engine.vsync = false;
     _engine.isRunning = false;
     _engine.initialized = true;
+
+    if (_frameArena.first == NULL)
+        SSGE_Arena_Create(&_frameArena, 0);
     _engine.fullscreen = false;
     _engine.resizable = false;
 }
 
+// The backbuffer is recreated at the size of the window on the next frame
+inline static void _resetBackbuffer() {
+    if (_engine.backbuffer == NULL) return;
+    SDL_DestroyTexture(_engine.backbuffer);
+    _engine.backbuffer = NULL;
+}
+
 SSGEAPI void SSGE_Quit() {
     if (!_engine.initialized)
         SSGE_Error("Engine not initialized");
 
+    SSGE_Trace_Stop();
+    flushTextCache(true);
+    SSGE_Arena_Destroy(&_frameArena);
+    SSGE_SpriteBatch_Destroy(&_spriteBatch);
+    destroyStaticLayers();
+    _resetBackbuffer();
+
     SSGE_Array_Destroy(&_objectList, (SSGE_DestroyData)destroyObject);
     SSGE_Array_Destroy(&_objectTemplateList, (SSGE_DestroyData)destroyTemplate);
     SSGE_Array_Destroy(&_fontList, (SSGE_DestroyData)destroyFont);
     SSGE_Array_Destroy(&_audioList, (SSGE_DestroyData)destroyAudio);
     SSGE_Array_Destroy(&_animationList, (SSGE_DestroyData)destroyAnimation);
-    SSGE_Array_Destroy(&_playingAnim, free);
+    SSGE_Array_Destroy(&_playingAnim, (SSGE_DestroyData)destroyAnimationState);
     SSGE_Array_Destroy(&_textureList, (SSGE_DestroyData)destroyTexture);
 
+    SSGE_Transforms_Destroy(&_objectTransforms);
+    SSGE_Grid_Destroy(&_renderGrid);
+    SSGE_Pool_Destroy(&_objectPool);
+    SSGE_Pool_Destroy(&_animStatePool);
+    SSGE_Intern_Destroy();
+    SSGE_Pool_Destroy(&_namePool);
+
     if (_engine.title) free(_engine.title);
     if (_engine.icon) SDL_FreeSurface(_engine.icon);
 
-    SDL_DestroyRenderer(_engine.renderer);
-    SDL_DestroyWindow(_engine.window);
-    Mix_CloseAudio();
-    Mix_Quit();
+    if (_engine.renderer) SDL_DestroyRenderer(_engine.renderer);
+    if (_engine.window) SDL_DestroyWindow(_engine.window);
+    if (_engine.offscreen) SDL_FreeSurface(_engine.offscreen);
+    if (_engine.audio) {
+        Mix_CloseAudio();
+        Mix_Quit();
+    }
     SDL_Quit();
 }
 
+// The region of the world seen by the camera, updated by `_updateTextures`
+static SDL_Rect _view;
+
 inline static bool _isTextureVisible(int x, int y, int width, int height) {
-    return !((x + width) < 0 || x >= _engine.width || (y + height) < 0 || y >= _engine.height);
+    return !((x + width) < _view.x || x >= _view.x + _view.w || (y + height) < _view.y || y >= _view.y + _view.h);
+}
+
+inline static void _renderData(SSGE_Texture *texture, _SSGE_RenderData *data) {
+    if (!_isTextureVisible(data->dest.x, data->dest.y, data->dest.w, data->dest.h)) return;
+
+    // The background callback runs before the commands are submitted and may move, add or remove render data, the commands keep a copy
+    if (_engine.partialRedraw) {
+        _SSGE_RenderData *copy = (_SSGE_RenderData *)SSGE_Arena_Alloc(&_frameArena, sizeof(_SSGE_RenderData));
+        *copy = *data;
+        data = copy;
+    }
+
+    SSGE_CommandQueue_Push(&_renderCommands, texture->texture, texture->sortKey, _TEXTURE_SRC(texture), data);
 }
 
+static void _renderNode(_SSGE_GridNode *node) {
+    SSGE_Texture *texture = node->texture;
+    _SSGE_RenderData *data = SSGE_RenderQueue_Get(&texture->queue, node->renderId);
+    if (_staticLayers.count == 0) {
+        _renderData(texture, data);
+        return;
+    }
+
+    // The render data of a static layer are only pushed when its cache is redrawn
+    _SSGE_StaticLayer *layer = staticLayer(data->layer);
+    if (layer == NULL) {
+        _renderData(texture, data);
+    } else if (layer->dirty && _isTextureVisible(data->dest.x, data->dest.y, data->dest.w, data->dest.h)) {
+        SSGE_CommandQueue_Push(&layer->commands, texture->texture, texture->sortKey, _TEXTURE_SRC(texture), data);
+    }
+}
+
+// The one-shot render data must stay valid until the render commands are submitted
+inline static void _clearTextures() {
+    for (uint32_t i = 0; i < _textureList.count; i++) {
+        SSGE_Texture *texture = _textureList.array[i];
+
+        // What is drawn once must be erased on the next frame
+        if (_engine.partialRedraw)
+            for (uint32_t j = 0; j < texture->queue.onceCount; j++)
+                markDrawDamage(&texture->queue.once[j]);
+        texture->queue.onceCount = 0;
+    }
+}
+
+// The texture part of the sort key of the last texture, animation frames continue from it
+static uint32_t _sortKey;
+
 inline static void _updateTextures() {
-    for (uint32_t i = 0, textureDone = 0; textureDone < _textureList.count && i < _textureList.size; i++) {
-        SSGE_Texture *texture = SSGE_Array_Get(&_textureList, i);
-        if (!texture) continue;
-
-        ++textureDone;
-        SDL_Texture *sdlTexture = texture->texture;
-        uint32_t count = texture->queue.count;
-        uint32_t size = texture->queue.size;
-
-        for (uint32_t j = 0, dataDone = 0; dataDone < count && j < size; j++) {
-            _SSGE_RenderData *data = SSGE_Array_Get(&texture->queue, j);
-            if (!data) continue;
-            
-            ++dataDone;
-            if (!_isTextureVisible(data->dest.x, data->dest.y, data->dest.w, data->dest.h)) continue;
-
-            if (data->angle == 0 && data->flip == 0) SDL_RenderCopy(_engine.renderer, sdlTexture, NULL, &data->dest);
-            else SDL_RenderCopyEx(_engine.renderer, sdlTexture, NULL, &data->dest, data->angle, (SDL_Point *)&data->rotationCenter, data->flip);
-
-            if (data->once) free(SSGE_Array_Pop(&texture->queue, j));
+    static uint32_t frame = 0;
+    ++frame;
+
+    cameraView(&_view);
+
+    // Every texture of a built atlas page shares the sort key of the page so their draws are batched together
+    uint32_t size = _staticLayers.count;
+    for (uint32_t i = 0; i < _playingAnim.count; i++) {
+        _SSGE_AnimationClock *clock = ((SSGE_AnimationState *)_playingAnim.array[i])->clock;
+        size += clock ? clock->count : 1;
+    }
+    uint32_t persistentCount = 0;
+    _sortKey = 0;
+    for (uint32_t i = 0; i < _textureList.count; i++) {
+        SSGE_Texture *texture = _textureList.array[i];
+        size += texture->queue.persistentCount + texture->queue.onceCount;
+        persistentCount += texture->queue.persistentCount;
+
+        SSGE_Atlas *atlas = texture->atlas;
+        if (atlas == NULL || !atlas->built) {
+            texture->sortKey = ++_sortKey;
+            continue;
         }
+
+        if (atlas->drawnFrame == frame) continue;
+        atlas->drawnFrame = frame;
+        SDL_Texture *page = NULL;
+        for (uint32_t j = 0; j < atlas->count; j++) {
+            SSGE_Texture *entry = atlas->entries[j].texture;
+            if (entry->texture != page) {
+                page = entry->texture;
+                ++_sortKey;
+            }
+            entry->sortKey = _sortKey;
+        }
+    }
+    SSGE_CommandQueue_Begin(&_renderCommands, size);
+    beginStaticLayers(persistentCount);
+
+    // Only the persistent render data in the cells seen by the camera are visited
+    SSGE_Grid_Query(&_renderGrid, &_view, _renderNode);
+
+    for (uint32_t i = 0; i < _textureList.count; i++) {
+        SSGE_Texture *texture = _textureList.array[i];
+        for (uint32_t j = 0; j < texture->queue.onceCount; j++)
+            _renderData(texture, &texture->queue.once[j]);
     }
+
+    renderStaticLayers(&_view, &_sortKey);
 }
 
-inline static void _updateAnimations() {
-    for (uint32_t i = 0, stateDone = 0; stateDone < _playingAnim.count && i < _playingAnim.size; i++) {
-        SSGE_AnimationState *state = SSGE_Array_Get(&_playingAnim, i);
-        if (state == NULL || !state->isPlaying) continue;
+// Moves an animation state `time` microseconds forward, returns true if the animation ended
+inline static bool _advanceAnimation(SSGE_AnimationState *state, uint64_t time) {
+    struct _SSGE_AnimationData *anim = &state->animation->data;
+    if (anim->currentCount == 0) return false;
+
+    uint32_t frame = state->currentFrame;
+    time += state->currentFrameTime;
+    while (time >= anim->frametimes[state->currentFrame]) {
+        time -= anim->frametimes[state->currentFrame];
+        state->currentFrame += 1 - 2*state->reversed;
+
+        if (state->currentFrame < anim->currentCount)
+            continue;
+
+        if (!(state->loop || state->pingpong)) // If there is no play count modifier
+            return true;
+
+        if (state->pingpong) { // If pingpong then we need to decrement the frame (according to the reversed state)
+            state->currentFrame -= 2 * (1 - 2*state->reversed);
+            state->reversed = !state->reversed;
+            if (state->currentFrame >= anim->currentCount) state->currentFrame = 0; // Single frame
+        } else { // else just restart from the first frame (the last one if reversed)
+            state->currentFrame = state->reversed ? anim->currentCount - 1 : 0;
+        }
+
+        // If not loop then we can set pingpong to false (whatever the state of pingpong)
+        if (!state->loop)
+            state->pingpong = false;
+
+        if (state->loop && state->loop != -1) --state->loop; // Decrement loop count
+
+        // Right after a wrap the state repeats every cycle, the whole cycles are skipped at once
+        uint64_t cycle = anim->duration;
+        uint32_t wraps = 1;
+        if (state->pingpong) { // Forward then backward, the first and last frames are shown once per cycle
+            cycle = anim->currentCount == 1 ? 2 * cycle : 2 * cycle - anim->frametimes[0] - anim->frametimes[anim->currentCount - 1];
+            wraps = 2;
+        }
+        uint64_t cycles = time / cycle;
+        if (state->loop != -1 && cycles > state->loop / wraps) cycles = state->loop / wraps;
+        time -= cycles * cycle;
+        if (state->loop != -1) state->loop -= (uint32_t)cycles * wraps;
+    }
+    state->currentFrameTime = (uint32_t)time;
+
+    if (state->currentFrame != frame)
+        markAnimationDamage(state);
+    return false;
+}
+
+// Moves the playing animations `dt` milliseconds forward, visible or not
+inline static void _advanceAnimations(double dt) {
+    uint64_t time = (uint64_t)(dt * 1000.0);
+    for (uint32_t i = 0; i < _playingAnim.count; i++) {
+        SSGE_AnimationState *state = _playingAnim.array[i];
         if (!state->isPlaying) continue;
 
+        if (state->animation->type == SSGE_ANIM_FUNCTION) {
+            markAnimationDamage(state); // Drawn again every frame
+        } else if (_advanceAnimation(state, time)) { // The last state is moved at this position
+            markAnimationDamage(state);
+            destroyAnimationState(SSGE_Array_Pop(&_playingAnim, SSGE_Array_IdAt(&_playingAnim, i)));
+            --i;
+        }
+    }
+    profileMark(SSGE_PHASE_ANIMATIONS);
+}
+
+// Pushes a frame of an animation drawn at a position, if it is visible
+inline static void _pushAnimationFrame(const SSGE_AnimationState *state, uint32_t frame, int x, int y, uint32_t textureKey) {
+    struct _SSGE_AnimationData *anim = &state->animation->data;
+    SDL_Rect dest = {
+        x - anim->anchorX,
+        y - anim->anchorY,
+        anim->width,
+        anim->height,
+    };
+    if (!_isTextureVisible(dest.x, dest.y, dest.w, dest.h)) return;
+
+    _SSGE_RenderData *data = (_SSGE_RenderData *)SSGE_Arena_Alloc(&_frameArena, sizeof(_SSGE_RenderData));
+    *data = (_SSGE_RenderData){
+        .dest = dest,
+        .layer = state->layer,
+        .depth = state->depth
+    };
+    const SDL_Rect *src = anim->frames[frame] == anim->sheet ? &anim->srcRects[frame] : NULL;
+    SSGE_CommandQueue_Push(&_renderCommands, anim->frames[frame], textureKey, src, data);
+}
+
+// The sort key given to a texture drawn by the animations this frame
+typedef struct _FrameKey {
+    SDL_Texture *texture;
+    uint32_t    key;
+} _FrameKey;
+
+/**
+ * Gets the sort key of a frame texture, giving it the next key on its first draw of the frame
+ * \param keys The keys of the frame textures, open addressing with linear probing
+ * \param mask The size of the key table minus one
+ * \param texture The frame texture
+ * \return The sort key of the texture
+ */
+inline static uint32_t _frameKey(_FrameKey *keys, uint32_t mask, SDL_Texture *texture) {
+    uint32_t pos = (uint32_t)((uintptr_t)texture >> 4) * 0x9E3779B1u & mask;
+    while (keys[pos].texture != NULL && keys[pos].texture != texture)
+        pos = (pos + 1) & mask;
+    if (keys[pos].texture == NULL)
+        keys[pos] = (_FrameKey){texture, ++_sortKey};
+    return keys[pos].key;
+}
+
+// Pushes the current frames of the visible animations into the render commands
+inline static void _updateAnimations() {
+    uint32_t draws = 0;
+    for (uint32_t i = 0; i < _playingAnim.count; i++) {
+        _SSGE_AnimationClock *clock = ((SSGE_AnimationState *)_playingAnim.array[i])->clock;
+        draws += clock ? clock->count : 1;
+    }
+    if (draws == 0) return;
+
+    // The key comes from the texture, so every frame of a sprite sheet, whatever its animation or state, is drawn together
+    uint32_t size = 2;
+    while (size < draws * 2) size *= 2;
+    _FrameKey *keys = (_FrameKey *)SSGE_Arena_Alloc(&_frameArena, sizeof(_FrameKey) * size);
+    memset(keys, 0, sizeof(_FrameKey) * size);
+
+    for (uint32_t i = 0; i < _playingAnim.count; i++) {
+        SSGE_AnimationState *state = _playingAnim.array[i];
         SSGE_Animation *anim = state->animation;
-        switch (anim->type) {
-            case SSGE_ANIM_FRAMES:
-                SDL_Rect dest = {
-                    state->x - anim->data.anchorX,
-                    state->y - anim->data.anchorY,
-                    anim->data.width,
-                    anim->data.height,
-                };
-                if (!_isTextureVisible(dest.x, dest.y, dest.w, dest.h)) {
-                    if (!(state->loop || state->pingpong)) // If there is no play count modifier
-                        SSGE_Array_Remove(&_playingAnim, i, free);
-                    break;
-                }
+        if (!state->isPlaying || anim->type != SSGE_ANIM_FRAMES || anim->data.currentCount == 0) continue;
+
+        _SSGE_AnimationClock *clock = state->clock;
+        if (clock == NULL) {
+            uint32_t key = _frameKey(keys, size - 1, anim->data.frames[state->currentFrame]);
+            _pushAnimationFrame(state, state->currentFrame, state->x, state->y, key);
+            continue;
+        }
+
+        for (uint32_t j = 0; j < clock->count; j++) {
+            _SSGE_AnimationInstance *instance = &clock->instances[j];
+            uint32_t frame = (state->currentFrame + instance->phase) % anim->data.currentCount;
+            _pushAnimationFrame(state, frame, instance->x, instance->y, _frameKey(keys, size - 1, anim->data.frames[frame]));
+        }
+    }
+}
 
-                SDL_RenderCopy(_engine.renderer, anim->data.frames[state->currentFrame], NULL, &dest);
+inline static void _drawAnimationFunctions() {
+    for (uint32_t i = 0; i < _playingAnim.count; i++) {
+        SSGE_AnimationState *state = _playingAnim.array[i];
+        if (state->isPlaying && state->animation->type == SSGE_ANIM_FUNCTION)
+            state->animation->draw(state);
+    }
+}
+
+// Submits the render commands through the camera, clipped to its viewport and to a region of the window
+inline static void _submitCommands(const SDL_Rect *region) {
+    SDL_Rect clip;
+    cameraViewport(&clip);
+    if (region != NULL) {
+        int x0 = clip.x > region->x ? clip.x : region->x;
+        int y0 = clip.y > region->y ? clip.y : region->y;
+        int x1 = clip.x + clip.w < region->x + region->w ? clip.x + clip.w : region->x + region->w;
+        int y1 = clip.y + clip.h < region->y + region->h ? clip.y + clip.h : region->y + region->h;
+        if (x1 <= x0 || y1 <= y0) return;
+        clip = (SDL_Rect){x0, y0, x1 - x0, y1 - y0};
+    }
+
+    float scale, offsetX, offsetY;
+    cameraTransform(&scale, &offsetX, &offsetY);
+    SSGE_SpriteBatch_SetTransform(&_spriteBatch, scale, offsetX, offsetY);
 
-                if (state->currentFrameTime++ >= anim->data.frametimes[state->currentFrame]) {
-                    state->currentFrame += 1 - 2*state->reversed;
-                    state->currentFrameTime = 0;
-                }
+    SDL_RenderSetClipRect(_engine.renderer, &clip);
+    cameraUnapply(&clip);
+    SSGE_CommandQueue_Submit(&_renderCommands, &_spriteBatch, &clip);
+    SDL_RenderSetClipRect(_engine.renderer, region);
+}
+
+inline static void _renderFrame() {
+    _updateTextures();
+    profileMark(SSGE_PHASE_TEXTURES);
+    _updateAnimations();
+    profileMark(SSGE_PHASE_ANIMATIONS);
+
+    SSGE_CommandQueue_Sort(&_renderCommands);
+    _submitCommands(NULL);
+    _clearTextures();
+
+    _drawAnimationFunctions();
+    profileMark(SSGE_PHASE_SUBMIT);
+}
 
-                if (state->currentFrame < anim->data.currentCount)
+// Redraws the damaged regions in the backbuffer, then presents it
+inline static void _renderPartial(SSGE_DrawFunc background, SSGE_DrawFunc draw, void *data, bool present) {
+    if (_engine.backbuffer == NULL) {
+        _engine.backbuffer = SDL_CreateTexture(_engine.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, _engine.width, _engine.height);
+        if (_engine.backbuffer == NULL)
+            SSGE_ErrorEx("Failed to create backbuffer: %s", SDL_GetError())
+        SSGE_Damage_AddAll(&_damage);
+    }
+    if (_updateFrame) {
+        SSGE_Damage_AddAll(&_damage);
+        _updateFrame = false;
+    }
+
+    // Playing animations damage the window when they advance, nothing to redraw otherwise
+    if (SSGE_Damage_IsEmpty(&_damage)) {
+        _clearTextures(); // Drawn out of the window
+        return;
+    }
+
+    _updateTextures();
+    profileMark(SSGE_PHASE_TEXTURES);
+    _updateAnimations();
+    profileMark(SSGE_PHASE_ANIMATIONS);
+
+    SSGE_CommandQueue_Sort(&_renderCommands);
+
+    // The callbacks run once, so what they draw is queued once: a single pass redraws the bounding box of the damage
+    SDL_Rect rect;
+    SSGE_Damage_GetBounds(&_damage, &rect);
+
+    // What the callbacks draw or damage is for the next frame, like in the full redraw
+    SSGE_Damage_Clear(&_damage);
+    _clearTextures();
+
+    SDL_SetRenderTarget(_engine.renderer, _engine.backbuffer);
+    SDL_RenderSetClipRect(_engine.renderer, &rect);
+
+    // SDL_RenderClear ignores the clip rect
+    SDL_SetRenderDrawBlendMode(_engine.renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(_engine.renderer, _bgColor.r, _bgColor.g, _bgColor.b, _bgColor.a);
+    SDL_RenderFillRect(_engine.renderer, &rect);
+    SDL_SetRenderDrawBlendMode(_engine.renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(_engine.renderer, _color.r, _color.g, _color.b, _color.a);
+    profileMark(SSGE_PHASE_CLEAR);
+
+    if (background) background(data);
+    profileMark(SSGE_PHASE_BACKGROUND);
+    _submitCommands(&rect);
+    _drawAnimationFunctions();
+    profileMark(SSGE_PHASE_SUBMIT);
+    if (draw) draw(data);
+    profileMark(SSGE_PHASE_DRAW);
+
+    SDL_RenderSetClipRect(_engine.renderer, NULL);
+    SDL_SetRenderTarget(_engine.renderer, NULL);
+
+    if (present) {
+        SDL_RenderCopy(_engine.renderer, _engine.backbuffer, NULL, NULL);
+        profileOverlay();
+        SDL_RenderPresent(_engine.renderer);
+        profileMark(SSGE_PHASE_PRESENT);
+    }
+    flushTextCache(false);
+}
+
+inline static void _pollEvents(SSGE_EventHandler eventHandler, void *data) {
+    SSGE_Event event = {0};
+    while (SDL_PollEvent((SDL_Event *)&event)) {
+        switch (event.type) {
+            case SDL_QUIT:
+            _engine.isRunning = false;
+            break;
+            case SDL_WINDOWEVENT:
+            switch (event.window.event) {
+                case SDL_WINDOWEVENT_SIZE_CHANGED:
+                    _engine.width = event.window.data1;
+                    _engine.height = event.window.data2;
+                    _resetBackbuffer();
+                    break;
+                case SDL_WINDOWEVENT_MINIMIZED:
+                case SDL_WINDOWEVENT_HIDDEN:
+                    _engine.hidden = true;
+                    break;
+                case SDL_WINDOWEVENT_RESTORED:
+                case SDL_WINDOWEVENT_SHOWN:
+                case SDL_WINDOWEVENT_MAXIMIZED:
+                case SDL_WINDOWEVENT_EXPOSED:
+                    // The content of the window may be lost
+                    _engine.hidden = false;
+                    _updateFrame = true;
                     break;
+            }
+            break;
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+            // The static layers and the backbuffer are render targets, their content is lost
+            invalidateLayers();
+            _resetBackbuffer();
+            break;
+        }
+        if (eventHandler) eventHandler(event, data);
+    }
+}
 
-                if (!(state->loop || state->pingpong)) // If there is no play count modifier
-                    SSGE_Array_Remove(&_playingAnim, i, free);
+inline static void _drawFrame(SSGE_DrawFunc background, SSGE_DrawFunc draw, void *data, bool present) {
+    if (_engine.renderer == NULL) {
+        // Nothing is drawn without renderer
+    } else if (_engine.hidden) {
+        _clearTextures(); // Nothing is seen
+    } else if (_engine.partialRedraw) {
+        _renderPartial(background, draw, data, present);
+    } else if (_updateFrame || !_manualUpdateFrame || _engine.vsync) {
+        SDL_SetRenderDrawColor(_engine.renderer, _bgColor.r, _bgColor.g, _bgColor.b, _bgColor.a);
+        SDL_RenderClear(_engine.renderer);
+        SDL_SetRenderDrawColor(_engine.renderer, _color.r, _color.g, _color.b, _color.a);
+        profileMark(SSGE_PHASE_CLEAR);
+
+        if (background) background(data);
+        profileMark(SSGE_PHASE_BACKGROUND);
+
+        _renderFrame();
+
+        if (draw) draw(data);
+        profileMark(SSGE_PHASE_DRAW);
+
+        if (present) {
+            profileOverlay();
+            SDL_RenderPresent(_engine.renderer);
+            profileMark(SSGE_PHASE_PRESENT);
+        }
+        flushTextCache(false);
+        _updateFrame = false;
+    }
+
+    SSGE_Arena_Reset(&_frameArena);
+    profileEnd();
+}
+
+// Time not yet consumed by an update, in milliseconds
+static double _updateTime = 0;
 
-                if (state->pingpong) { // If pingpong then we need to decrement the frame (according to the reversed state)
-                    state->currentFrame -= 2 * (1 - 2*state->reversed);
-                    state->reversed = !state->reversed;
-                } else { // else just set the frame to 0
-                    state->currentFrame = 0;
-                }
+// Part of the next update elapsed when the frame is drawn
+static double _alpha = 0;
 
-                // If not loop then we can set pingpong to false (whatever the state of pingpong)
-                if (!state->loop)
-                    state->pingpong = false;
+// Runs the updates due after `dt` milliseconds, at most `maxUpdates`
+inline static void _runUpdates(double dt, uint32_t maxUpdates, SSGE_UpdateFunc update, void *data) {
+    double frameTime = 1000.0 / (double)(_engine.fps);
+    _updateTime += dt;
+
+    uint32_t updates = 0;
+    while (_updateTime >= frameTime && updates < maxUpdates) {
+        if (update) update(data);
+        _updateTime -= frameTime;
+        ++updates;
+    }
+
+    // Too far behind, the late updates are dropped instead of slowing every next frame down
+    if (_updateTime >= frameTime) _updateTime = fmod(_updateTime, frameTime);
+    _alpha = _updateTime / frameTime;
+    profileMark(SSGE_PHASE_UPDATE);
+}
 
-                if (state->loop && state->loop != -1) --state->loop; // Decrement loop count
-                break;
+// Sleeps most of the time left, then spins for the last milliseconds that `SDL_Delay` can't hit precisely
+inline static void _waitUntil(uint64_t deadline, uint64_t frequency) {
+    uint64_t now = SDL_GetPerformanceCounter();
+    if (now >= deadline) return;
 
-            case SSGE_ANIM_FUNCTION:
-                anim->draw(state);
-                break;
+    uint64_t spin = frequency * _SPIN_TIME / 1000;
+    if (deadline - now > spin)
+        SDL_Delay((uint32_t)((deadline - now - spin) * 1000 / frequency));
+    while (SDL_GetPerformanceCounter() < deadline);
+}
+
+// If nothing has to be drawn or animated until the next event
+inline static bool _isIdle() {
+    if (_engine.partialRedraw ? !SSGE_Damage_IsEmpty(&_damage) || _updateFrame : !_manualUpdateFrame || _updateFrame)
+        return false;
+    for (uint32_t i = 0; i < _playingAnim.count; i++)
+        if (((SSGE_AnimationState *)_playingAnim.array[i])->isPlaying) return false;
+    return true;
+}
+
+// Blocks until an event arrives, or a wake up is due, returns false if it did not block
+inline static bool _waitIdle() {
+    int timeout;
+    if (_engine.idle && _isIdle()) timeout = -1;
+    else if (_engine.hidden) timeout = _HIDDEN_FRAME_TIME;
+    else return false;
+
+    if (_engine.wakeup != 0) {
+        uint64_t now = SDL_GetPerformanceCounter();
+        if (now >= _engine.wakeup) {
+            _engine.wakeup = 0;
+            return false;
         }
-        ++stateDone;
+        uint64_t ms = (_engine.wakeup - now) * 1000 / SDL_GetPerformanceFrequency() + 1;
+        if (timeout < 0 || ms < (uint64_t)timeout) timeout = (int)ms;
     }
+
+    // The event is left in the queue for the event handler
+    if (timeout < 0) SDL_WaitEvent(NULL);
+    else SDL_WaitEventTimeout(NULL, timeout);
+    return true;
 }
 
 SSGEAPI void SSGE_Run(SSGE_UpdateFunc update, SSGE_DrawFunc background, SSGE_DrawFunc draw, SSGE_EventHandler eventHandler, void *data) {
     if (!_engine.initialized)
         SSGE_Error("Engine not initialized");
 
-    uint64_t frameStart;
-    double targetFrameTime = 1000.0 / (double)(_engine.fps);
-    uint64_t nextUpdate = SDL_GetTicks64() + (uint64_t)targetFrameTime;
+    uint64_t frequency = SDL_GetPerformanceFrequency();
+    uint64_t previous = SDL_GetPerformanceCounter();
 
     _engine.isRunning = true;
-    SSGE_Event event = {0};
 
     while (_engine.isRunning) {
-        frameStart = SDL_GetTicks64();
-
-        while (SDL_PollEvent((SDL_Event *)&event)) {
-            switch (event.type) {
-                case SDL_QUIT:
-                _engine.isRunning = false;
-                break;
-                case SDL_WINDOWEVENT:
-                switch (event.window.event) {
-                    case SDL_WINDOWEVENT_SIZE_CHANGED:
-                        _engine.width = event.window.data1;
-                        _engine.height = event.window.data2;
-                        break;
-                }
-                break;
-            }
-            if (eventHandler) eventHandler(event, data);
+        // The time spent waiting is not simulated, a single update runs after it
+        if (_waitIdle()) {
+            previous = SDL_GetPerformanceCounter();
+            _updateTime = 1000.0 / (double)(_engine.fps);
         }
+        profileBegin();
+
+        _pollEvents(eventHandler, data);
+        profileMark(SSGE_PHASE_EVENTS);
+
+        uint64_t now = SDL_GetPerformanceCounter();
+        double elapsed = (double)(now - previous) * 1000.0 / (double)frequency;
+        _runUpdates(elapsed, _engine.maxFrameskip, update, data);
+        _advanceAnimations(elapsed);
+        previous = now;
+
+        _drawFrame(background, draw, data, true);
 
-        int updateLoops = 0;
-        uint64_t currentTime = SDL_GetTicks64();
-        if (update) while (currentTime > nextUpdate && updateLoops++ < _engine.maxFrameskip) {
-            update(data);
-            nextUpdate += (uint64_t)targetFrameTime;
+        // Wake up when the next update is due, VSync paces the frames otherwise
+        if (!_engine.vsync) {
+            double frameTime = 1000.0 / (double)(_engine.fps);
+            _waitUntil(now + (uint64_t)((frameTime - _updateTime) * (double)frequency / 1000.0), frequency);
         }
-        
-        if (_updateFrame || !_manualUpdateFrame || _engine.vsync) {
-            SDL_SetRenderDrawColor(_engine.renderer, _bgColor.r, _bgColor.g, _bgColor.b, _bgColor.a);
-            SDL_RenderClear(_engine.renderer);
-            SDL_SetRenderDrawColor(_engine.renderer, _color.r, _color.g, _color.b, _color.a);
+    }
+}
 
-            if (background) background(data);
+SSGEAPI double SSGE_GetInterpolation() {
+    return _alpha;
+}
 
-            _updateTextures();
-            _updateAnimations();
+SSGEAPI bool SSGE_Step(double dt, bool present, SSGE_UpdateFunc update, SSGE_DrawFunc background, SSGE_DrawFunc draw, SSGE_EventHandler eventHandler, void *data) {
+    if (!_engine.initialized)
+        SSGE_Error("Engine not initialized");
 
-            if (draw) draw(data);
+    _engine.isRunning = true;
+    profileBegin();
+    _pollEvents(eventHandler, data);
+    profileMark(SSGE_PHASE_EVENTS);
 
-            SDL_RenderPresent(_engine.renderer);
-            _updateFrame = false;
-        }
+    // Updates run at the fixed rate of the engine, whatever the wall clock says
+    _runUpdates(dt, UINT32_MAX, update, data);
+    _advanceAnimations(dt);
 
-        if (!_engine.vsync) {
-            for (; updateLoops > 0; updateLoops--) {
-                targetFrameTime = 1000.0 / (double)(_engine.fps);
-                uint64_t frameTime = SDL_GetTicks64() - frameStart;
-                if ((double)frameTime < targetFrameTime)
-                    SDL_Delay((uint32_t)(targetFrameTime - (double)frameTime));
-            }
-        }
+    _drawFrame(background, draw, data, present);
+    return _engine.isRunning;
+}
+
+SSGEAPI uint32_t SSGE_RunFrames(uint32_t count, SSGE_UpdateFunc update, SSGE_DrawFunc background, SSGE_DrawFunc draw, SSGE_EventHandler eventHandler, void *data) {
+    uint32_t frames = 0;
+    while (frames < count) {
+        ++frames;
+        if (!SSGE_Step(1000.0 / (double)(_engine.fps), true, update, background, draw, eventHandler, data)) break;
     }
+    return frames;
 }
 
 SSGEAPI void SSGE_SetWindowTitle(const char *title) {
@@ -274,6 +778,7 @@ SSGEAPI void SSGE_WindowResize(uint16_t width, uint16_t height) {
     _engine.width = width;
     _engine.height = height;
     SDL_SetWindowSize(_engine.window, width, height);
+    _resetBackbuffer();
 }
 
 SSGEAPI void SSGE_WindowResizable(bool resizable) {
@@ -310,8 +815,37 @@ SSGEAPI void SSGE_ManualUpdate() {
     _updateFrame = true;
 }
 
+SSGEAPI void SSGE_SetIdleMode(bool idle) {
+    _engine.idle = idle;
+}
+
+SSGEAPI void SSGE_WakeAfter(uint32_t ms) {
+    uint64_t wakeup = SDL_GetPerformanceCounter() + SDL_GetPerformanceFrequency() * ms / 1000;
+    if (_engine.wakeup == 0 || wakeup < _engine.wakeup) _engine.wakeup = wakeup;
+}
+
 SSGEAPI void SSGE_SetBackgroundColor(SSGE_Color color) {
     _bgColor = color;
+    if (_engine.partialRedraw) SSGE_Damage_AddAll(&_damage);
+}
+
+SSGEAPI void SSGE_SetPartialRedraw(bool partialRedraw) {
+    _engine.partialRedraw = partialRedraw;
+    if (partialRedraw) SSGE_Damage_AddAll(&_damage);
+    else {
+        _resetBackbuffer();
+        SSGE_Damage_Clear(&_damage);
+    }
+}
+
+SSGEAPI void SSGE_ManualUpdateRect(int x, int y, int width, int height) {
+    if (_engine.partialRedraw)
+        SSGE_Damage_Add(&_damage, &(SDL_Rect){x, y, width, height});
+}
+
+SSGEAPI void SSGE_SetDrawLayer(int16_t layer, uint16_t depth) {
+    _drawLayer = layer;
+    _drawDepth = depth;
 }
 
 SSGEAPI void SSGE_GetMousePosition(int *x, int *y) {
@@ -347,6 +881,12 @@ SSGEAPI bool SSGE_GetVSync() {
     return _engine.vsync;
 }
 
+SSGEAPI void SSGE_GetStats(SSGE_Stats *stats) {
+    stats->frameArenaHighWater = _frameArena.highWater;
+    stats->internedBytes = _internTable.bytes;
+    stats->internedNames = _internTable.count;
+}
+
 SSGEAPI struct SDL_Renderer *SSGE_getRenderer() {
     return _engine.renderer;
 }
\ No newline at end of file
@@ -10,18 +10,37 @@ SSGEAPI SSGE_Animation *SSGE_Animation_CreateFrames(uint32_t *id, const char *na
 
     anim->type = SSGE_ANIM_FRAMES;
     anim->data.frames = (SDL_Texture **)calloc(frameCount, sizeof(SDL_Texture *));
-    anim->data.frametimes = (uint8_t *)calloc(frameCount, sizeof(uint8_t));
+    anim->data.frametimes = (uint32_t *)calloc(frameCount, sizeof(uint32_t));
     anim->data.frameCount = frameCount;
     anim->data.currentCount = 0;
+    anim->data.duration = 0;
     anim->data.width = width;
     anim->data.height = height;
     anim->data.anchorX = 0;
     anim->data.anchorY = 0;
+    anim->data.sheet = NULL;
+    anim->data.srcRects = NULL;
 
     _addToList(&_animationList, anim, name, id, __func__);
     return anim;
 }
 
+SSGEAPI SSGE_Animation *SSGE_Animation_CreateSheet(uint32_t *id, const char *name, SSGE_Tilemap *tilemap, uint16_t row, uint16_t col, uint32_t frameCount, uint32_t duration) {
+    if (row >= tilemap->nbRows || col >= tilemap->nbCols)
+        SSGE_ErrorEx2("Tile out of bounds (row: %u col: %u)", row, col)
+
+    // The frames follow each other in the rows of the tilemap
+    uint32_t first = (uint32_t)row * tilemap->nbCols + col;
+    if (frameCount > (uint32_t)tilemap->nbRows * tilemap->nbCols - first)
+        SSGE_ErrorEx("Not enough tiles for %u frames", frameCount)
+
+    SSGE_Animation *anim = SSGE_Animation_CreateFrames(id, name, frameCount, tilemap->tileWidth, tilemap->tileHeight);
+    for (uint32_t i = first; i < first + frameCount; i++)
+        SSGE_Animation_AddFrameSheet(anim, duration, tilemap, i / tilemap->nbCols, i % tilemap->nbCols);
+
+    return anim;
+}
+
 SSGEAPI SSGE_Animation *SSGE_Animation_CreateFunc(uint32_t *id, const char *name, void (*draw)(SSGE_AnimationState *)) {
     SSGE_Animation *anim = (SSGE_Animation *)malloc(sizeof(SSGE_Animation));
     if (anim == NULL) 
@@ -42,6 +61,28 @@ SSGEAPI void SSGE_Animation_Anchor(SSGE_Animation *animation, int x, int y) {
     animation->data.anchorY = y;
 }
 
+/**
+ * Converts a frametime in frames of the engine into microseconds
+ * \param frametime The frametime in frames, a frame is shown during `frametime + 1` frames
+ * \return The duration in microseconds
+ */
+static uint32_t _frameDuration(uint8_t frametime) {
+    return ((uint32_t)frametime + 1) * 1000000 / _engine.fps;
+}
+
+/**
+ * Appends a frame to an animation
+ * \param animation The animation
+ * \param frame The texture of the frame
+ * \param duration The duration of the frame in microseconds, at least 1
+ */
+static void _appendFrame(SSGE_Animation *animation, SDL_Texture *frame, uint32_t duration) {
+    if (duration == 0) duration = 1;
+    animation->data.frames[animation->data.currentCount] = frame;
+    animation->data.frametimes[animation->data.currentCount++] = duration;
+    animation->data.duration += duration;
+}
+
 SSGEAPI void SSGE_Animation_AddFrame(SSGE_Animation *animation, uint8_t frametime, const char *filename) {
     if (animation->type != SSGE_ANIM_FRAMES)
         SSGE_Error("Wrong animation type")
@@ -53,8 +94,7 @@ SSGEAPI void SSGE_Animation_AddFrame(SSGE_Animation *animation, uint8_t frametim
     if (animation->data.currentCount >= animation->data.frameCount)
         SSGE_Error("Animation already have max number of frames")
 
-    animation->data.frames[animation->data.currentCount] = frame;
-    animation->data.frametimes[animation->data.currentCount++] = frametime;
+    _appendFrame(animation, frame, _frameDuration(frametime));
 }
 
 SSGEAPI void SSGE_Animation_AddFrameTilemap(SSGE_Animation *animation, uint8_t frametime, SSGE_Tilemap *tilemap, int row, int col) {
@@ -74,8 +114,42 @@ SSGEAPI void SSGE_Animation_AddFrameTilemap(SSGE_Animation *animation, uint8_t f
     if (animation->data.currentCount >= animation->data.frameCount)
         SSGE_Error("Animation already have max number of frames")
 
-    animation->data.frames[animation->data.currentCount] = frame;
-    animation->data.frametimes[animation->data.currentCount++] = frametime;
+    _appendFrame(animation, frame, _frameDuration(frametime));
+}
+
+SSGEAPI void SSGE_Animation_AddFrameSheet(SSGE_Animation *animation, uint32_t duration, SSGE_Tilemap *tilemap, uint16_t row, uint16_t col) {
+    if (animation->type != SSGE_ANIM_FRAMES)
+        SSGE_Error("Wrong animation type")
+
+    if (row >= tilemap->nbRows || col >= tilemap->nbCols)
+        SSGE_ErrorEx2("Tile out of bounds (row: %u col: %u)", row, col)
+
+    if (animation->data.currentCount >= animation->data.frameCount)
+        SSGE_Error("Animation already have max number of frames")
+
+    if (animation->data.sheet == NULL) {
+        animation->data.srcRects = (SDL_Rect *)calloc(animation->data.frameCount, sizeof(SDL_Rect));
+        if (animation->data.srcRects == NULL)
+            SSGE_Error("Failed to allocate memory for frames")
+        animation->data.sheet = tilemap->texture;
+    } else if (animation->data.sheet != tilemap->texture) {
+        SSGE_Error("Animation already uses another sprite sheet")
+    }
+
+    animation->data.srcRects[animation->data.currentCount] = (SDL_Rect){col * (tilemap->tileWidth + tilemap->spacing), row * (tilemap->tileHeight + tilemap->spacing), tilemap->tileWidth, tilemap->tileHeight};
+    _appendFrame(animation, tilemap->texture, duration);
+}
+
+SSGEAPI void SSGE_Animation_SetFrameDuration(SSGE_Animation *animation, uint32_t frame, uint32_t duration) {
+    if (animation->type != SSGE_ANIM_FRAMES)
+        SSGE_Error("Wrong animation type")
+
+    if (frame >= animation->data.currentCount)
+        SSGE_ErrorEx("Frame not found: %u", frame)
+
+    if (duration == 0) duration = 1;
+    animation->data.duration += (uint64_t)duration - animation->data.frametimes[frame];
+    animation->data.frametimes[frame] = duration;
 }
 
 SSGEAPI SSGE_Animation *SSGE_Animation_Get(uint32_t id) {
@@ -85,21 +159,20 @@ SSGEAPI SSGE_Animation *SSGE_Animation_Get(uint32_t id) {
     return ptr;
 }
 
-inline static bool _find_animation_name(void *ptr, void *name) {
-    return strcmp(((SSGE_Animation *)ptr)->name, (char *)name) == 0;
-}
-
 SSGEAPI SSGE_Animation *SSGE_Animation_GetName(const char *name) {
-    SSGE_Animation *ptr = SSGE_Array_Find(&_animationList, _find_animation_name, (void *)name);
+    SSGE_Animation *ptr = SSGE_Array_GetName(&_animationList, name);
     if (ptr == NULL)
         SSGE_ErrorEx("Animation not found: %s", name)
     return ptr;
 }
 
-SSGEAPI uint32_t SSGE_Animation_Play(SSGE_Animation *animation, int x, int y, uint32_t loop, bool reversed, bool pingpong) {
-    SSGE_AnimationState *state = (SSGE_AnimationState*)malloc(sizeof(SSGE_AnimationState));
-    if (state == NULL)
-        SSGE_Error("Failed to allocate memory for animation state")
+/**
+ * Starts playing an animation
+ * \param clock The instances drawn from the state, NULL to draw it at its own position
+ * \return The id of the animation state
+ */
+static uint32_t _play(SSGE_Animation *animation, int x, int y, uint32_t loop, bool reversed, bool pingpong, _SSGE_AnimationClock *clock) {
+    SSGE_AnimationState *state = (SSGE_AnimationState *)SSGE_Pool_Alloc(&_animStatePool);
 
     state->animation = animation;
     state->x = x;
@@ -110,16 +183,158 @@ SSGEAPI uint32_t SSGE_Animation_Play(SSGE_Animation *animation, int x, int y, ui
     state->reversed = reversed;
     state->pingpong = pingpong;
     state->isPlaying = true;
+    state->layer = _drawLayer;
+    state->depth = _drawDepth;
+    state->clock = clock;
+    markAnimationDamage(state);
 
     return SSGE_Array_Add(&_playingAnim, state);
 }
 
+/**
+ * Finds a shared animation state
+ * \param id The id of the shared animation state
+ * \return The shared animation state, NULL if it is not found
+ */
+static SSGE_AnimationState *_findShared(uint32_t id) {
+    SSGE_AnimationState *state = SSGE_Array_Get(&_playingAnim, id);
+    return state != NULL && state->clock != NULL ? state : NULL;
+}
+
+/**
+ * Gets a shared animation state, throws an error if it is not found
+ * \param id The id of the shared animation state
+ * \return The shared animation state
+ */
+static SSGE_AnimationState *_getShared(uint32_t id) {
+    SSGE_AnimationState *state = _findShared(id);
+    if (state == NULL)
+        SSGE_ErrorEx("Shared animation state not found: %u", id)
+    return state;
+}
+
+SSGEAPI uint32_t SSGE_Animation_Play(SSGE_Animation *animation, int x, int y, uint32_t loop, bool reversed, bool pingpong) {
+    return _play(animation, x, y, loop, reversed, pingpong, NULL);
+}
+
+SSGEAPI uint32_t SSGE_Animation_PlayShared(SSGE_Animation *animation, uint32_t loop, bool reversed, bool pingpong) {
+    if (animation->type != SSGE_ANIM_FRAMES)
+        SSGE_Error("Wrong animation type")
+
+    _SSGE_AnimationClock *clock = (_SSGE_AnimationClock *)malloc(sizeof(_SSGE_AnimationClock));
+    if (clock == NULL)
+        SSGE_Error("Failed to allocate memory for animation clock")
+
+    clock->instances = NULL;
+    clock->count = 0;
+    clock->size = 0;
+    SSGE_SlotTable_Create(&clock->slots, 0, SSGE_ARRAY_MIN_FREE_SLOTS); // The instances are handed to the user
+
+    return _play(animation, 0, 0, loop, reversed, pingpong, clock);
+}
+
+/**
+ * Adds an instance to a shared animation state
+ * \param id The id of the shared animation state
+ * \param x The x coordinate of the instance
+ * \param y The y coordinate of the instance
+ * \param phase The number of frames the instance is ahead of the others
+ * \return The id of the instance, `UINT32_MAX` if the state does not exist (it has ended or has been stopped)
+ */
+uint32_t addAnimationInstance(uint32_t id, int x, int y, uint32_t phase) {
+    SSGE_AnimationState *state = _findShared(id);
+    if (state == NULL) return UINT32_MAX;
+    _SSGE_AnimationClock *clock = state->clock;
+
+    if (clock->count >= clock->size) {
+        uint32_t size = clock->size ? clock->size * 2 : 8;
+        _SSGE_AnimationInstance *instances = (_SSGE_AnimationInstance *)realloc(clock->instances, sizeof(_SSGE_AnimationInstance) * size);
+        if (instances == NULL)
+            SSGE_Error("Failed to allocate memory for animation instances")
+        SSGE_SlotTable_Grow(&clock->slots, size);
+        clock->instances = instances;
+        clock->size = size;
+    }
+
+    _SSGE_AnimationInstance *instance = &clock->instances[clock->count];
+    *instance = (_SSGE_AnimationInstance){
+        .x = x,
+        .y = y,
+        .phase = phase
+    };
+    markInstanceDamage(state, instance);
+
+    return SSGE_SlotTable_Alloc(&clock->slots, clock->count++);
+}
+
+SSGEAPI uint32_t SSGE_Animation_AddInstance(uint32_t id, int x, int y, uint32_t phase) {
+    _getShared(id);
+    return addAnimationInstance(id, x, y, phase);
+}
+
+/**
+ * Moves an instance of a shared animation state
+ * \param id The id of the shared animation state
+ * \param instance The id of the instance
+ * \param x The x coordinate of the instance
+ * \param y The y coordinate of the instance
+ * \return True if the instance was moved, false if the state or the instance does not exist
+ */
+bool moveAnimationInstance(uint32_t id, uint32_t instance, int x, int y) {
+    SSGE_AnimationState *state = _findShared(id);
+    if (state == NULL) return false;
+
+    uint32_t pos = SSGE_SlotTable_Resolve(&state->clock->slots, state->clock->count, instance);
+    if (pos == UINT32_MAX) return false;
+
+    _SSGE_AnimationInstance *ptr = &state->clock->instances[pos];
+    markInstanceDamage(state, ptr);
+    ptr->x = x;
+    ptr->y = y;
+    markInstanceDamage(state, ptr);
+    return true;
+}
+
+SSGEAPI void SSGE_Animation_MoveInstance(uint32_t id, uint32_t instance, int x, int y) {
+    _getShared(id);
+    if (!moveAnimationInstance(id, instance, x, y))
+        SSGE_ErrorEx("Animation instance not found: %u", instance)
+}
+
+/**
+ * Removes an instance of a shared animation state
+ * \param id The id of the shared animation state
+ * \param instance The id of the instance
+ * \return True if the instance was removed, false if the state or the instance does not exist
+ */
+bool removeAnimationInstance(uint32_t id, uint32_t instance) {
+    SSGE_AnimationState *state = _findShared(id);
+    if (state == NULL) return false;
+
+    _SSGE_AnimationClock *clock = state->clock;
+    uint32_t pos = SSGE_SlotTable_Resolve(&clock->slots, clock->count, instance);
+    if (pos == UINT32_MAX) return false;
+
+    // The last instance is moved at this position
+    markInstanceDamage(state, &clock->instances[pos]);
+    uint32_t last = --clock->count;
+    SSGE_SlotTable_Free(&clock->slots, pos, last);
+    clock->instances[pos] = clock->instances[last];
+    return true;
+}
+
+SSGEAPI void SSGE_Animation_RemoveInstance(uint32_t id, uint32_t instance) {
+    if (!removeAnimationInstance(id, instance))
+        SSGE_ErrorEx("Animation instance not found: %u", instance)
+}
+
 SSGEAPI void SSGE_Animation_Pause(uint32_t id) {
     SSGE_AnimationState *state = SSGE_Array_Get(&_playingAnim, id);
     if (state == NULL)
         SSGE_ErrorEx("Animation state not found: %u", id)
 
     state->isPlaying = false;
+    markAnimationDamage(state);
 }
 
 SSGEAPI void SSGE_Animation_Resume(uint32_t id) {
@@ -128,6 +343,7 @@ SSGEAPI void SSGE_Animation_Resume(uint32_t id) {
         SSGE_ErrorEx("Animation state not found: %u", id)
 
     state->isPlaying = true;
+    markAnimationDamage(state);
 }
 
 SSGEAPI void SSGE_Animation_Stop(uint32_t id) {
@@ -135,7 +351,8 @@ SSGEAPI void SSGE_Animation_Stop(uint32_t id) {
     if (state == NULL)
         SSGE_ErrorEx("Animation state not found: %u", id)
 
-    free(state);
+    markAnimationDamage(state);
+    destroyAnimationState(state);
 }
 
 SSGEAPI void SSGE_Animation_Move(uint32_t id, int x, int y) {
@@ -143,6 +360,18 @@ SSGEAPI void SSGE_Animation_Move(uint32_t id, int x, int y) {
     if (state == NULL)
         SSGE_ErrorEx("Animation state not found: %u", id);
     
+    markAnimationDamage(state);
     state->x = x;
     state->y = y;
+    markAnimationDamage(state);
+}
+
+SSGEAPI void SSGE_Animation_SetLayer(uint32_t id, int16_t layer, uint16_t depth) {
+    SSGE_AnimationState *state = SSGE_Array_Get(&_playingAnim, id);
+    if (state == NULL)
+        SSGE_ErrorEx("Animation state not found: %u", id)
+
+    state->layer = layer;
+    state->depth = depth;
+    markAnimationDamage(state);
 }
@@ -0,0 +1,143 @@
+#include <stdlib.h>
+#include <stddef.h>
+
+#include "SSGE_local.h"
+#include "SSGE_arena.h"
+#include "SSGE_error.h"
+#include "SSGE/SSGE.h"
+
+#define _ALIGNMENT          _Alignof(max_align_t)
+#define _ALIGN(size)        (((size) + _ALIGNMENT - 1) & ~(size_t)(_ALIGNMENT - 1))
+#define _BLOCK_HEADER_SIZE  _ALIGN(sizeof(_SSGE_ArenaBlock))
+#define _BLOCK_DATA(block)  ((uint8_t *)(block) + _BLOCK_HEADER_SIZE)
+#define _DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/**
+ * Allocates a new arena block
+ * \param size The size of the block data
+ * \return The block
+ */
+static _SSGE_ArenaBlock *_newBlock(size_t size) {
+    _SSGE_ArenaBlock *block = (_SSGE_ArenaBlock *)malloc(_BLOCK_HEADER_SIZE + size);
+    if (block == NULL)
+        SSGE_Error("Failed to allocate memory for arena block")
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+/**
+ * Creates an arena
+ * \param arena The arena to initialize
+ * \param blockSize The size of the first block of the arena
+ */
+SSGEAPI void SSGE_Arena_Create(_SSGE_Arena *arena, size_t blockSize) {
+    arena->blockSize = blockSize ? _ALIGN(blockSize) : _DEFAULT_BLOCK_SIZE;
+    arena->first = arena->current = _newBlock(arena->blockSize);
+    arena->used = 0;
+    arena->highWater = 0;
+}
+
+/**
+ * Allocates memory from an arena
+ * \param arena The arena
+ * \param size The number of bytes to allocate
+ * \return The pointer to the memory, aligned for any type
+ */
+SSGEAPI void *SSGE_Arena_Alloc(_SSGE_Arena *arena, size_t size) {
+    if (arena->first == NULL)
+        SSGE_Arena_Create(arena, 0);
+
+    size = _ALIGN(size ? size : 1);
+    _SSGE_ArenaBlock *block = arena->current;
+    while (block->size - block->used < size) {
+        if (block->next == NULL || block->next->size < size) { // Insert a block large enough
+            _SSGE_ArenaBlock *newBlock = _newBlock(size > arena->blockSize ? size : arena->blockSize);
+            newBlock->next = block->next;
+            block->next = newBlock;
+        }
+
+        // The skipped end of the block is counted, so the high-water mark is the size of a single block fitting the frame
+        arena->used += block->size - block->used;
+        block->used = block->size;
+        block = block->next;
+        block->used = 0;
+    }
+    arena->current = block;
+
+    void *ptr = _BLOCK_DATA(block) + block->used;
+    block->used += size;
+    arena->used += size;
+    if (arena->used > arena->highWater)
+        arena->highWater = arena->used;
+    return ptr;
+}
+
+/**
+ * Rewinds an arena to a previous allocation, freeing it and everything allocated after it
+ * \param arena The arena
+ * \param ptr The pointer returned by `SSGE_Arena_Alloc`
+ */
+SSGEAPI void SSGE_Arena_Rewind(_SSGE_Arena *arena, void *ptr) {
+    _SSGE_ArenaBlock *block = arena->current;
+    if (block == NULL) return;
+
+    uint8_t *top = _BLOCK_DATA(block) + block->used;
+    if ((uint8_t *)ptr < _BLOCK_DATA(block) || (uint8_t *)ptr >= top) return;
+
+    size_t freed = (size_t)(top - (uint8_t *)ptr);
+    block->used -= freed;
+    arena->used -= freed;
+}
+
+/**
+ * Resets an arena, freeing every allocation at once
+ * \param arena The arena
+ */
+SSGEAPI void SSGE_Arena_Reset(_SSGE_Arena *arena) {
+    if (arena->first == NULL) return;
+
+    if (arena->first->next != NULL) { // Merge the blocks so the next frame fits in the first one
+        size_t size = arena->first->size;
+        for (_SSGE_ArenaBlock *block = arena->first->next, *next; block != NULL; block = next) {
+            next = block->next;
+            size += block->size;
+            free(block);
+        }
+        free(arena->first);
+        arena->first = _newBlock(size);
+    }
+    arena->current = arena->first;
+    arena->first->used = 0;
+    arena->used = 0;
+}
+
+/**
+ * Destroys an arena
+ * \param arena The arena to destroy
+ */
+SSGEAPI void SSGE_Arena_Destroy(_SSGE_Arena *arena) {
+    for (_SSGE_ArenaBlock *block = arena->first, *next; block != NULL; block = next) {
+        next = block->next;
+        free(block);
+    }
+    arena->first = arena->current = NULL;
+    arena->used = 0;
+}
+
+SSGEAPI void *SSGE_FrameAlloc(size_t size) {
+    return SSGE_Arena_Alloc(&_frameArena, size);
+}
+
+SSGEAPI size_t SSGE_GetFrameArenaHighWater() {
+    return _frameArena.highWater;
+}
+
+SSGEAPI void SSGE_SetFrameArenaSize(size_t size) {
+    if (_frameArena.used != 0)
+        SSGE_Error("Frame arena is in use")
+
+    SSGE_Arena_Destroy(&_frameArena);
+    SSGE_Arena_Create(&_frameArena, size);
+}
@@ -0,0 +1,58 @@
+// Internal arena (bump allocator) functions
+
+#ifndef __SSGE_ARENA_H__
+#define __SSGE_ARENA_H__
+
+#include <stddef.h>
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern _SSGE_Arena _frameArena;
+
+/**
+ * Create an arena
+ * \param arena The arena to initialize
+ * \param blockSize The size of the first block of the arena
+ */
+SSGEAPI void SSGE_Arena_Create(_SSGE_Arena *arena, size_t blockSize);
+
+/**
+ * Allocate memory from an arena
+ * \param arena The arena
+ * \param size The number of bytes to allocate
+ * \return The pointer to the memory, aligned for any type
+ * \note The memory stays valid until the arena is reset or rewound before it
+ */
+SSGEAPI void *SSGE_Arena_Alloc(_SSGE_Arena *arena, size_t size);
+
+/**
+ * Rewind an arena to a previous allocation, freeing it and everything allocated after it
+ * \param arena The arena
+ * \param ptr The pointer returned by `SSGE_Arena_Alloc`
+ * \note Does nothing if the allocation is not in the current block of the arena
+ */
+SSGEAPI void SSGE_Arena_Rewind(_SSGE_Arena *arena, void *ptr);
+
+/**
+ * Reset an arena, freeing every allocation at once
+ * \param arena The arena
+ * \note If the arena needed more than one block, they are merged into a single one
+ */
+SSGEAPI void SSGE_Arena_Reset(_SSGE_Arena *arena);
+
+/**
+ * Destroy an arena
+ * \param arena The arena to destroy
+ */
+SSGEAPI void SSGE_Arena_Destroy(_SSGE_Arena *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_ARENA_H__
@@ -3,25 +3,392 @@
 #include "SSGE_local.h"
 #include "SSGE_error.h"
 
-#define _INITIAL_SIZE 256
+#define _MIN_SIZE 8
 #define _IDX_PILE_INITIAL_SIZE 64
 #define _GROWTH_FACTOR 2
+#define _NAME_INDEX_INITIAL_SIZE 64
+
+#define _SLOT(id)       ((id) & SSGE_ARRAY_SLOT_MASK)
+#define _GENERATION(id) ((id) >> SSGE_ARRAY_SLOT_BITS)
+
+/**
+ * Finds the entry of a name in a name index
+ * \param index The name index
+ * \param name The interned name to find
+ * \param hash The hash of the name
+ * \return The position of the entry of the name, or of the empty entry where it should be inserted
+ * \note Names are interned, so they are compared by pointer
+ */
+static uint32_t _nameIndexProbe(_SSGE_NameIndex *index, const char *name, uint32_t hash) {
+    uint32_t mask = index->size - 1;
+    uint32_t pos = hash & mask;
+    while (index->entries[pos].name != NULL && index->entries[pos].name != name)
+        pos = (pos + 1) & mask;
+    return pos;
+}
+
+/**
+ * Grows the table of a name index
+ * \param index The name index to grow
+ */
+static void _nameIndexGrow(_SSGE_NameIndex *index) {
+    struct _SSGE_NameEntry *old = index->entries;
+    uint32_t oldSize = index->size;
+
+    index->entries = (struct _SSGE_NameEntry *)calloc(oldSize * _GROWTH_FACTOR, sizeof(struct _SSGE_NameEntry));
+    if (index->entries == NULL)
+        SSGE_Error("Failed to realloc name index")
+    index->size = oldSize * _GROWTH_FACTOR;
+
+    uint32_t mask = index->size - 1;
+    for (uint32_t i = 0; i < oldSize; i++) {
+        if (old[i].name == NULL) continue;
+        uint32_t pos = old[i].hash & mask;
+        while (index->entries[pos].name != NULL)
+            pos = (pos + 1) & mask;
+        index->entries[pos] = old[i];
+    }
+    free(old);
+}
+
+/**
+ * Removes an entry from a name index, shifting back the entries that follow it
+ * \param index The name index
+ * \param pos The position of the entry to remove
+ */
+static void _nameIndexErase(_SSGE_NameIndex *index, uint32_t pos) {
+    uint32_t mask = index->size - 1;
+    for (uint32_t next = (pos + 1) & mask; index->entries[next].name != NULL; next = (next + 1) & mask) {
+        uint32_t home = index->entries[next].hash & mask;
+        if (((next - home) & mask) >= ((next - pos) & mask)) {
+            index->entries[pos] = index->entries[next];
+            pos = next;
+        }
+    }
+    index->entries[pos].name = NULL;
+    --index->count;
+}
+
+/**
+ * Gets the position of an id in the name index links
+ * \param array The array
+ * \param id The id of the element
+ * \return The position of the element in the `next` and `prev` arrays
+ */
+static inline uint32_t _nameLink(SSGE_Array *array, uint32_t id) {
+    return array->slots ? _SLOT(id) : id;
+}
+
+/**
+ * Adds an element of an array to its name index
+ * \param array The array
+ * \param element The element
+ * \param id The id of the element
+ */
+static void _nameIndexInsert(SSGE_Array *array, void *element, uint32_t id) {
+    _SSGE_NameIndex *index = array->names;
+    const char *name = ((DummyType *)element)->name;
+    if (name == NULL) return;
+
+    uint32_t link = _nameLink(array, id);
+    if (link >= index->linkSize) {
+        // Slots can go past the size of the array while the unused ones wait, so the links grow geometrically
+        uint32_t linkSize = index->linkSize ? index->linkSize * _GROWTH_FACTOR : _MIN_SIZE;
+        if (linkSize < array->size) linkSize = array->size;
+        if (array->slots && linkSize < array->slots->slotSize) linkSize = array->slots->slotSize;
+        if (linkSize <= link) linkSize = link + 1;
+        uint32_t *next = (uint32_t *)realloc(index->next, sizeof(uint32_t) * linkSize);
+        uint32_t *prev = (uint32_t *)realloc(index->prev, sizeof(uint32_t) * linkSize);
+        if (next == NULL || prev == NULL)
+            SSGE_Error("Failed to realloc name index links")
+        index->next = next;
+        index->prev = prev;
+        index->linkSize = linkSize;
+    }
+
+    if ((index->count + 1) * 4 > index->size * 3)
+        _nameIndexGrow(index);
+
+    uint32_t hash = SSGE_Intern_Hash(name);
+    struct _SSGE_NameEntry *entry = &index->entries[_nameIndexProbe(index, name, hash)];
+    if (entry->name == NULL) {
+        *entry = (struct _SSGE_NameEntry){name, hash, id};
+        index->next[link] = index->prev[link] = id;
+        ++index->count;
+        return;
+    }
+
+    // Append to the circular list of the elements holding this name
+    uint32_t first = entry->first, last = index->prev[_nameLink(array, first)];
+    index->next[_nameLink(array, last)] = id;
+    index->prev[link] = last;
+    index->next[link] = first;
+    index->prev[_nameLink(array, first)] = id;
+}
+
+/**
+ * Removes an element of an array from its name index
+ * \param array The array
+ * \param element The element, must still be in the array
+ * \param id The id of the element
+ */
+static void _nameIndexRemove(SSGE_Array *array, void *element, uint32_t id) {
+    _SSGE_NameIndex *index = array->names;
+    const char *name = ((DummyType *)element)->name;
+    if (name == NULL) return;
+
+    uint32_t pos = _nameIndexProbe(index, name, SSGE_Intern_Hash(name));
+    struct _SSGE_NameEntry *entry = &index->entries[pos];
+    if (entry->name == NULL) return;
+
+    uint32_t link = _nameLink(array, id);
+    uint32_t next = index->next[link], prev = index->prev[link];
+    if (next == id) { // Last element holding this name
+        _nameIndexErase(index, pos);
+        return;
+    }
+
+    index->next[_nameLink(array, prev)] = next;
+    index->prev[_nameLink(array, next)] = prev;
+    if (entry->first == id) {
+        entry->first = next;
+        entry->name = ((DummyType *)SSGE_Array_Get(array, next))->name;
+    }
+}
+
+/**
+ * Pushes an index on the pile of unused indexes of an array
+ * \param array The array
+ * \param idx The index to push
+ */
+static void _pushIndex(SSGE_Array *array, uint32_t idx) {
+    if (array->idxSize <= array->idxCount) {
+        uint32_t idxSize = array->idxSize ? array->idxSize * _GROWTH_FACTOR : _IDX_PILE_INITIAL_SIZE;
+        uint32_t *newIndexes = (uint32_t *)realloc(array->indexes, sizeof(uint32_t) * idxSize);
+        if (newIndexes == NULL) 
+            SSGE_Error("Failed to realloc array indexes pile")
+        array->indexes = newIndexes;
+        array->idxSize = idxSize;
+    }
+    array->indexes[array->idxCount++] = idx;
+}
+
+/**
+ * Creates a slot table
+ * \param table The slot table to initialize
+ * \param size The initial size of the table
+ * \param minFree The number of unused slots kept before reusing the oldest one
+ */
+SSGEAPI void SSGE_SlotTable_Create(_SSGE_SlotTable *table, uint32_t size, uint32_t minFree) {
+    table->slots = NULL;
+    table->owners = NULL;
+    table->generations = NULL;
+    table->size = 0;
+    table->slotSize = 0;
+    table->slotCount = 0;
+    table->freeSlot = UINT32_MAX;
+    table->freeTail = UINT32_MAX;
+    table->freeCount = 0;
+    table->minFree = minFree;
+    SSGE_SlotTable_Grow(table, size);
+}
+
+/**
+ * Grows the slot arrays of a slot table
+ * \param table The slot table
+ * \param size The new size of the slot arrays
+ */
+static void _slotsGrow(_SSGE_SlotTable *table, uint32_t size) {
+    if (size <= table->slotSize) return;
+    if (size > SSGE_ARRAY_SLOT_MASK + 1)
+        size = SSGE_ARRAY_SLOT_MASK + 1;
+
+    uint32_t *newSlots = (uint32_t *)realloc(table->slots, sizeof(uint32_t) * size);
+    if (newSlots == NULL)
+        SSGE_Error("Failed to realloc slot table")
+    table->slots = newSlots;
+    uint8_t *newGenerations = (uint8_t *)realloc(table->generations, sizeof(uint8_t) * size);
+    if (newGenerations == NULL)
+        SSGE_Error("Failed to realloc slot table")
+    table->generations = newGenerations;
+    table->slotSize = size;
+}
+
+/**
+ * Grows a slot table
+ * \param table The slot table to grow
+ * \param size The new size of the table
+ */
+SSGEAPI void SSGE_SlotTable_Grow(_SSGE_SlotTable *table, uint32_t size) {
+    if (size <= table->size) return;
+    if (size > SSGE_ARRAY_SLOT_MASK)
+        SSGE_Error("Slot table is full")
+
+    uint32_t *newOwners = (uint32_t *)realloc(table->owners, sizeof(uint32_t) * size);
+    if (newOwners == NULL)
+        SSGE_Error("Failed to realloc slot table")
+    table->owners = newOwners;
+    table->size = size;
+    _slotsGrow(table, size);
+}
+
+/**
+ * Binds a new id to a position
+ * \param table The slot table
+ * \param pos The position of the new element, must be lower than the size of the table
+ * \return The id of the element
+ * \note Unused slots are reused oldest first, once more than `minFree` of them wait
+ */
+SSGEAPI uint32_t SSGE_SlotTable_Alloc(_SSGE_SlotTable *table, uint32_t pos) {
+    uint32_t slot;
+    if (table->freeCount > table->minFree || (table->freeCount > 0 && table->slotCount > SSGE_ARRAY_SLOT_MASK)) {
+        slot = table->freeSlot;
+        table->freeSlot = table->slots[slot];
+        if (--table->freeCount == 0) table->freeTail = UINT32_MAX;
+    } else {
+        if (table->slotCount > SSGE_ARRAY_SLOT_MASK)
+            SSGE_Error("Slot table is full")
+        if (table->slotCount >= table->slotSize)
+            _slotsGrow(table, table->slotSize ? table->slotSize * 2 : 16);
+        slot = table->slotCount++;
+        table->generations[slot] = 0;
+    }
+    table->owners[pos] = slot;
+    table->slots[slot] = pos;
+    return ((uint32_t)table->generations[slot] << SSGE_ARRAY_SLOT_BITS) | slot;
+}
+
+/**
+ * Resolves an id to the position of its element
+ * \param table The slot table
+ * \param count The number of elements
+ * \param id The id to resolve
+ * \return The position of the element, or `UINT32_MAX` if the id is invalid or stale
+ */
+SSGEAPI uint32_t SSGE_SlotTable_Resolve(_SSGE_SlotTable *table, uint32_t count, uint32_t id) {
+    uint32_t slot = _SLOT(id);
+    if (slot >= table->slotCount || table->generations[slot] != _GENERATION(id))
+        return UINT32_MAX;
+
+    uint32_t pos = table->slots[slot];
+    if (pos >= count || table->owners[pos] != slot)
+        return UINT32_MAX;
+    return pos;
+}
+
+/**
+ * Gets the id of the element at a position
+ * \param table The slot table
+ * \param pos The position of the element
+ * \return The id of the element
+ */
+SSGEAPI uint32_t SSGE_SlotTable_IdAt(_SSGE_SlotTable *table, uint32_t pos) {
+    uint32_t slot = table->owners[pos];
+    return ((uint32_t)table->generations[slot] << SSGE_ARRAY_SLOT_BITS) | slot;
+}
+
+/**
+ * Frees the id of the element at a position, and rebinds the id of the last element to this position
+ * \param table The slot table
+ * \param pos The position of the removed element
+ * \param last The position of the last element, which the caller moves to `pos`
+ */
+SSGEAPI void SSGE_SlotTable_Free(_SSGE_SlotTable *table, uint32_t pos, uint32_t last) {
+    uint32_t slot = table->owners[pos];
+
+    table->owners[pos] = table->owners[last];
+    table->slots[table->owners[pos]] = pos;
+
+    // Queued after the other unused slots
+    table->generations[slot] = (table->generations[slot] + 1) & UINT8_MAX;
+    table->slots[slot] = UINT32_MAX;
+    if (table->freeTail == UINT32_MAX) table->freeSlot = slot;
+    else table->slots[table->freeTail] = slot;
+    table->freeTail = slot;
+    ++table->freeCount;
+}
+
+/**
+ * Destroys a slot table
+ * \param table The slot table to destroy
+ */
+SSGEAPI void SSGE_SlotTable_Destroy(_SSGE_SlotTable *table) {
+    free(table->slots);
+    free(table->owners);
+    free(table->generations);
+}
 
 /**
  * Creates a new array
  * \param array The array to initialize
+ * \param capacity The initial capacity of the array, 0 to allocate on the first add
  */
-SSGEAPI void SSGE_Array_Create(SSGE_Array *array) {
-    array->array = (void **)calloc(_INITIAL_SIZE, sizeof(void *));
-    if (array->array == NULL) 
-        SSGE_Error("Failed to allocate memory for array")
-    array->size = _INITIAL_SIZE;
+SSGEAPI void SSGE_Array_Create(SSGE_Array *array, uint32_t capacity) {
+    if (capacity > 0) {
+        array->array = (void **)calloc(capacity, sizeof(void *));
+        if (array->array == NULL) 
+            SSGE_Error("Failed to allocate memory for array")
+    } else array->array = NULL;
+    array->size = capacity;
     array->count = 0;
-    array->indexes = (uint32_t *)malloc(sizeof(uint32_t) * _IDX_PILE_INITIAL_SIZE);
-    if (array->indexes == NULL) 
-        SSGE_Error("Failed to allocate memory for array indexes pile")
-    array->idxSize = _IDX_PILE_INITIAL_SIZE;
+    array->indexes = NULL; // Allocated on the first removal
+    array->idxSize = 0;
     array->idxCount = 0;
+    array->slots = NULL;
+    array->names = NULL;
+}
+
+/**
+ * Creates a new slot map
+ * \param array The array to initialize
+ * \param capacity The initial capacity of the slot map, 0 to allocate on the first add
+ */
+SSGEAPI void SSGE_Array_CreateSlotMap(SSGE_Array *array, uint32_t capacity) {
+    SSGE_Array_Create(array, capacity);
+    array->slots = (_SSGE_SlotTable *)malloc(sizeof(_SSGE_SlotTable));
+    if (array->slots == NULL)
+        SSGE_Error("Failed to allocate memory for slot map")
+    SSGE_SlotTable_Create(array->slots, capacity, SSGE_ARRAY_MIN_FREE_SLOTS);
+}
+
+/**
+ * Grows an array to hold at least a number of elements, in a single realloc
+ * \param array The array to grow
+ * \param count The number of elements the array must hold
+ */
+static void _arrayGrow(SSGE_Array *array, uint32_t count) {
+    uint32_t size = array->size ? array->size : _MIN_SIZE;
+    while (size < count) {
+        if (size > UINT32_MAX / _GROWTH_FACTOR)
+            SSGE_Error("Array size would overflow")
+        size *= _GROWTH_FACTOR;
+    }
+    if (size == array->size) return;
+
+    void **newArray = (void **)realloc(array->array, sizeof(void *) * size);
+    if (newArray == NULL) 
+        SSGE_Error("Failed to realloc array")
+    array->array = newArray;
+
+    // Set new memory to NULL
+    for (uint32_t i = array->size; i < size; i++)
+        array->array[i] = NULL;
+
+    if (array->slots)
+        SSGE_SlotTable_Grow(array->slots, size);
+
+    array->size = size;
+}
+
+/**
+ * Reserves space for elements that will be added to an array
+ * \param array The array
+ * \param count The number of elements that will be added
+ */
+SSGEAPI void SSGE_Array_Reserve(SSGE_Array *array, uint32_t count) {
+    if (count > UINT32_MAX - array->count)
+        SSGE_Error("Array size would overflow")
+    _arrayGrow(array, array->count + count);
 }
 
 /**
@@ -30,23 +397,14 @@ SSGEAPI void SSGE_Array_Create(SSGE_Array *array) {
  * \return The index of the element
  */
 SSGEAPI uint32_t SSGE_Array_Add(SSGE_Array *array, void *element) {
-    if (array->size <= array->count) { // if the array is full, extend
-        if (array->size > UINT32_MAX / _GROWTH_FACTOR)
-            SSGE_Error("Array size would overflow")
-        void **newArray = (void **)realloc(array->array, sizeof(void *) * array->size * _GROWTH_FACTOR);
-        if (newArray == NULL) 
-            SSGE_Error("Failed to realloc array")
-        array->array = newArray;
-
-        // Set new memory to NULL
-        for (uint32_t i = array->size; i < array->size * _GROWTH_FACTOR; i++)
-            array->array[i] = NULL;
-
-        array->size *= _GROWTH_FACTOR;
-    }
+    if (array->size <= array->count) // if the array is full, extend
+        _arrayGrow(array, array->count + 1);
 
     uint32_t index;
-    if (array->idxCount > 0) {
+    if (array->slots) {
+        array->array[array->count] = element;
+        index = SSGE_SlotTable_Alloc(array->slots, array->count);
+    } else if (array->idxCount > 0) {
         index = array->indexes[--array->idxCount];
         array->array[index] = element;
     } else {
@@ -54,6 +412,7 @@ SSGEAPI uint32_t SSGE_Array_Add(SSGE_Array *array, void *element) {
         array->array[index] = element;
     }
     ++array->count;
+    if (array->names) _nameIndexInsert(array, element, index);
     return index;
 }
 
@@ -64,12 +423,27 @@ SSGEAPI uint32_t SSGE_Array_Add(SSGE_Array *array, void *element) {
  * \return The pointer to the element
  */
 SSGEAPI void *SSGE_Array_Get(SSGE_Array *array, uint32_t idx) {
+    if (array->slots) {
+        uint32_t pos = SSGE_SlotTable_Resolve(array->slots, array->count, idx);
+        return pos == UINT32_MAX ? NULL : array->array[pos];
+    }
+
     if (idx >= array->size)
         return NULL;
 
     return array->array[idx];
 }
 
+/**
+ * Gets the id of the element at a position of a slot map
+ * \param array The slot map
+ * \param pos The dense position of the element, must be lower than `array->count`
+ * \return The id of the element
+ */
+SSGEAPI uint32_t SSGE_Array_IdAt(SSGE_Array *array, uint32_t pos) {
+    return SSGE_SlotTable_IdAt(array->slots, pos);
+}
+
 /**
  * Removes an element from an array
  * \param array The array to remove the element from
@@ -77,25 +451,8 @@ SSGEAPI void *SSGE_Array_Get(SSGE_Array *array, uint32_t idx) {
  * \param destroyData The function to destroy the element to remove from the array
  */
 SSGEAPI void SSGE_Array_Remove(SSGE_Array *array, uint32_t idx, void (*destroyData)(void *)) {
-    if (idx >= array->size) {
-        return;
-    }
-    if (array->array[idx] == NULL) {
-        return;
-    }
-
-    if (destroyData != NULL) destroyData(array->array[idx]);
-    array->array[idx] = NULL;
-    --array->count;
-
-    if (array->idxSize <= array->idxCount) {
-        uint32_t *newIndexes = (uint32_t *)realloc(array->indexes, sizeof(uint32_t) * array->idxSize * _GROWTH_FACTOR);
-        if (newIndexes == NULL) 
-            SSGE_Error("Failed to realloc array indexes pile");
-        array->indexes = newIndexes;
-        array->idxSize *= _GROWTH_FACTOR;
-    }
-    array->indexes[array->idxCount++] = idx;
+    void *element = SSGE_Array_Pop(array, idx);
+    if (element != NULL && destroyData != NULL) destroyData(element);
 }
 
 /**
@@ -105,22 +462,29 @@ SSGEAPI void SSGE_Array_Remove(SSGE_Array *array, uint32_t idx, void (*destroyDa
  * \return The pointer to the popped element
  */
 SSGEAPI void *SSGE_Array_Pop(SSGE_Array *array, uint32_t idx) {
+    if (array->slots) {
+        uint32_t pos = SSGE_SlotTable_Resolve(array->slots, array->count, idx);
+        if (pos == UINT32_MAX) return NULL;
+
+        void *element = array->array[pos];
+        if (array->names) _nameIndexRemove(array, element, idx);
+        uint32_t last = --array->count;
+        SSGE_SlotTable_Free(array->slots, pos, last);
+        array->array[pos] = array->array[last];
+        array->array[last] = NULL;
+        return element;
+    }
+
     if (idx >= array->size) 
         return NULL;
 
     void *element = array->array[idx];
     if (element == NULL) return NULL;
+    if (array->names) _nameIndexRemove(array, element, idx);
     array->array[idx] = NULL;
     --array->count;
 
-    if (array->idxSize <= array->idxCount) {
-        uint32_t *newIndexes = (uint32_t *)realloc(array->indexes, sizeof(uint32_t) * array->idxSize * _GROWTH_FACTOR);
-        if (newIndexes == NULL) 
-            SSGE_Error("Failed to realloc array indexes pile")
-        array->indexes = newIndexes;
-        array->idxSize *= _GROWTH_FACTOR;
-    }
-    array->indexes[array->idxCount++] = idx;
+    _pushIndex(array, idx);
     return element;
 }
 
@@ -132,6 +496,12 @@ SSGEAPI void *SSGE_Array_Pop(SSGE_Array *array, uint32_t idx) {
  * \return The pointer to the first element that matches the condition, or NULL if not found
  */
 SSGEAPI void *SSGE_Array_Find(SSGE_Array *array, bool (*condition)(void *, void *), void *argument) {
+    if (array->slots) {
+        for (uint32_t i = 0; i < array->count; i++)
+            if (condition(array->array[i], argument)) return array->array[i];
+        return NULL;
+    }
+
     uint32_t i = 0, count = 0;
     while (count < array->count && i < array->size) {
         void *element = array->array[i++];
@@ -152,6 +522,12 @@ SSGEAPI void *SSGE_Array_Find(SSGE_Array *array, bool (*condition)(void *, void
  * \return The pointer to the first element that matches the condition, or NULL if not found
  */
 SSGEAPI void *SSGE_Array_FindPop(SSGE_Array *array, bool (*condition)(void *, void *), void *argument) {
+    if (array->slots) {
+        for (uint32_t i = 0; i < array->count; i++)
+            if (condition(array->array[i], argument)) return SSGE_Array_Pop(array, SSGE_Array_IdAt(array, i));
+        return NULL;
+    }
+
     for (uint32_t i = 0, count = 0; count < array->count && i < array->size; i++) {
         void *element = array->array[i];
 
@@ -163,21 +539,103 @@ SSGEAPI void *SSGE_Array_FindPop(SSGE_Array *array, bool (*condition)(void *, vo
     return NULL;
 }
 
+/**
+ * Indexes the elements of an array by name
+ * \param array The array to index
+ * \note The elements of the array must start with a `char *name` field (see `DummyType`)
+ * \note The index is kept up to date by `SSGE_Array_Add`, `SSGE_Array_Remove` and `SSGE_Array_Pop`
+ */
+SSGEAPI void SSGE_Array_IndexNames(SSGE_Array *array) {
+    if (array->names) return;
+
+    array->names = (_SSGE_NameIndex *)malloc(sizeof(_SSGE_NameIndex));
+    if (array->names == NULL)
+        SSGE_Error("Failed to allocate memory for name index")
+    array->names->entries = (struct _SSGE_NameEntry *)calloc(_NAME_INDEX_INITIAL_SIZE, sizeof(struct _SSGE_NameEntry));
+    if (array->names->entries == NULL)
+        SSGE_Error("Failed to allocate memory for name index")
+    array->names->size = _NAME_INDEX_INITIAL_SIZE;
+    array->names->count = 0;
+    array->names->next = NULL;
+    array->names->prev = NULL;
+    array->names->linkSize = 0;
+
+    if (array->slots) {
+        for (uint32_t i = 0; i < array->count; i++)
+            _nameIndexInsert(array, array->array[i], SSGE_Array_IdAt(array, i));
+        return;
+    }
+
+    for (uint32_t i = 0, count = 0; count < array->count && i < array->size; i++) {
+        if (array->array[i] == NULL) continue;
+        _nameIndexInsert(array, array->array[i], i);
+        ++count;
+    }
+}
+
+/**
+ * Gets an element from an array by name
+ * \param array The array to get the element from, must be indexed by name
+ * \param name The name of the element to get
+ * \return The pointer to the first element added with this name, or NULL if not found
+ */
+SSGEAPI void *SSGE_Array_GetName(SSGE_Array *array, const char *name) {
+    if (name == NULL) return NULL;
+    name = SSGE_Intern_Find(name);
+    if (name == NULL) return NULL; // No element holds this name
+
+    struct _SSGE_NameEntry *entry = &array->names->entries[_nameIndexProbe(array->names, name, SSGE_Intern_Hash(name))];
+    if (entry->name == NULL) return NULL;
+    return SSGE_Array_Get(array, entry->first);
+}
+
+/**
+ * Pops an element from an array by name
+ * \param array The array to pop the element from, must be indexed by name
+ * \param name The name of the element to pop
+ * \return The pointer to the popped element, or NULL if not found
+ */
+SSGEAPI void *SSGE_Array_PopName(SSGE_Array *array, const char *name) {
+    if (name == NULL) return NULL;
+    name = SSGE_Intern_Find(name);
+    if (name == NULL) return NULL; // No element holds this name
+
+    struct _SSGE_NameEntry *entry = &array->names->entries[_nameIndexProbe(array->names, name, SSGE_Intern_Hash(name))];
+    if (entry->name == NULL) return NULL;
+    return SSGE_Array_Pop(array, entry->first);
+}
+
 /**
  * Destroys an array
  * \param array The array to destroy
  * \param destroyData The function to destroy the elements of the array. Can be `NULL`
  */
 SSGEAPI void SSGE_Array_Destroy(SSGE_Array *array, void (*destroyData)(void *)) {
-    uint32_t i = 0, count = 0;
-    while (count < array->count && i < array->size) {
-        void *element = array->array[i++];
+    if (array->slots) {
+        if (destroyData)
+            for (uint32_t i = 0; i < array->count; i++)
+                destroyData(array->array[i]);
+        SSGE_SlotTable_Destroy(array->slots);
+        free(array->slots);
+        array->slots = NULL;
+    } else {
+        uint32_t i = 0, count = 0;
+        while (count < array->count && i < array->size) {
+            void *element = array->array[i++];
 
-        if (element == NULL) continue;
-        if (destroyData) destroyData(element);
+            if (element == NULL) continue;
+            if (destroyData) destroyData(element);
 
-        ++count;
+            ++count;
+        }
     }
     free(array->array);
     free(array->indexes);
+    if (array->names) {
+        free(array->names->entries);
+        free(array->names->next);
+        free(array->names->prev);
+        free(array->names);
+        array->names = NULL;
+    }
 }
\ No newline at end of file
@@ -13,11 +13,89 @@
 extern "C" {
 #endif
 
+// Slot map ids: the lower bits are the slot, the upper bits are the generation of the slot
+#define SSGE_ARRAY_SLOT_BITS 24
+#define SSGE_ARRAY_SLOT_MASK ((1U << SSGE_ARRAY_SLOT_BITS) - 1)
+
+/**
+ * Number of unused slots kept before reusing the oldest one, by the slot tables of the ids handed to the user.
+ * Removed slots are reused in order, so a slot is reused at most once every `SSGE_ARRAY_MIN_FREE_SLOTS` allocations,
+ * and a stale id can only alias a new element after 256 reuses of its slot (its 8 bits generation wraps),
+ * that is after at least 256 * `SSGE_ARRAY_MIN_FREE_SLOTS` allocations
+ */
+#define SSGE_ARRAY_MIN_FREE_SLOTS 1024
+
+/**
+ * Create a slot table
+ * \param table The slot table to initialize
+ * \param size The initial size of the table
+ * \param minFree The number of unused slots kept before reusing the oldest one
+ * \note Tables whose ids are handed to the user keep `SSGE_ARRAY_MIN_FREE_SLOTS` unused slots,
+ * internal tables reuse them immediately with 0
+ */
+SSGEAPI void SSGE_SlotTable_Create(_SSGE_SlotTable *table, uint32_t size, uint32_t minFree);
+
+/**
+ * Grow a slot table
+ * \param table The slot table to grow
+ * \param size The new size of the table
+ */
+SSGEAPI void SSGE_SlotTable_Grow(_SSGE_SlotTable *table, uint32_t size);
+
+/**
+ * Bind a new id to a position
+ * \param table The slot table
+ * \param pos The position of the new element, must be lower than the size of the table
+ * \return The id of the element
+ */
+SSGEAPI uint32_t SSGE_SlotTable_Alloc(_SSGE_SlotTable *table, uint32_t pos);
+
+/**
+ * Resolve an id to the position of its element
+ * \param table The slot table
+ * \param count The number of elements
+ * \param id The id to resolve
+ * \return The position of the element, or `UINT32_MAX` if the id is invalid or stale
+ */
+SSGEAPI uint32_t SSGE_SlotTable_Resolve(_SSGE_SlotTable *table, uint32_t count, uint32_t id);
+
+/**
+ * Get the id of the element at a position
+ * \param table The slot table
+ * \param pos The position of the element
+ * \return The id of the element
+ */
+SSGEAPI uint32_t SSGE_SlotTable_IdAt(_SSGE_SlotTable *table, uint32_t pos);
+
+/**
+ * Free the id of the element at a position, and rebind the id of the last element to this position
+ * \param table The slot table
+ * \param pos The position of the removed element
+ * \param last The position of the last element, which the caller moves to `pos`
+ */
+SSGEAPI void SSGE_SlotTable_Free(_SSGE_SlotTable *table, uint32_t pos, uint32_t last);
+
+/**
+ * Destroy a slot table
+ * \param table The slot table to destroy
+ */
+SSGEAPI void SSGE_SlotTable_Destroy(_SSGE_SlotTable *table);
+
 /**
  * Creates a new array
  * \param array The array to initialize
+ * \param capacity The initial capacity of the array, 0 to allocate on the first add
  */
-SSGEAPI void SSGE_Array_Create(SSGE_Array *array);
+SSGEAPI void SSGE_Array_Create(SSGE_Array *array, uint32_t capacity);
+
+/**
+ * Creates a new slot map
+ * \param array The array to initialize
+ * \param capacity The initial capacity of the slot map, 0 to allocate on the first add
+ * \note The elements are densely packed in `array->array[0 .. array->count - 1]`, in no particular order
+ * \note Ids stay valid until the element is removed. Removed ids are detected, even if their slot is reused
+ */
+SSGEAPI void SSGE_Array_CreateSlotMap(SSGE_Array *array, uint32_t capacity);
 
 /**
  * Add an element to an array
@@ -26,6 +104,14 @@ SSGEAPI void SSGE_Array_Create(SSGE_Array *array);
  */
 SSGEAPI uint32_t SSGE_Array_Add(SSGE_Array *array, void *element);
 
+/**
+ * Reserve space for elements that will be added to an array
+ * \param array The array
+ * \param count The number of elements that will be added
+ * \note The array grows at most once, following `SSGE_Array_Add` calls don't realloc until `count` elements are added
+ */
+SSGEAPI void SSGE_Array_Reserve(SSGE_Array *array, uint32_t count);
+
 /**
  * Get an element from an array
  * \param array The array to get the element from
@@ -34,6 +120,14 @@ SSGEAPI uint32_t SSGE_Array_Add(SSGE_Array *array, void *element);
  */
 SSGEAPI void *SSGE_Array_Get(SSGE_Array *array, uint32_t idx);
 
+/**
+ * Get the id of the element at a position of a slot map
+ * \param array The slot map
+ * \param pos The position of the element, must be lower than `array->count`
+ * \return The id of the element
+ */
+SSGEAPI uint32_t SSGE_Array_IdAt(SSGE_Array *array, uint32_t pos);
+
 /**
  * Remove an element from an array
  * \param array The array to remove the element from
@@ -68,6 +162,30 @@ SSGEAPI void *SSGE_Array_Find(SSGE_Array *array, bool (*condition)(void *, void
  */
 SSGEAPI void *SSGE_Array_FindPop(SSGE_Array *array, bool (*condition)(void *, void *), void *arg);
 
+/**
+ * Index the elements of an array by name
+ * \param array The array to index
+ * \note The elements of the array must start with a `char *name` field (see `DummyType`)
+ * \note The index is kept up to date by `SSGE_Array_Add`, `SSGE_Array_Remove` and `SSGE_Array_Pop`
+ */
+SSGEAPI void SSGE_Array_IndexNames(SSGE_Array *array);
+
+/**
+ * Get an element from an array by name
+ * \param array The array to get the element from, must be indexed by name
+ * \param name The name of the element to get
+ * \return The pointer to the first element added with this name, or NULL if not found
+ */
+SSGEAPI void *SSGE_Array_GetName(SSGE_Array *array, const char *name);
+
+/**
+ * Pop an element from an array by name
+ * \param array The array to pop the element from, must be indexed by name
+ * \param name The name of the element to pop
+ * \return The pointer to the popped element, or NULL if not found
+ */
+SSGEAPI void *SSGE_Array_PopName(SSGE_Array *array, const char *name);
+
 /**
  * Destroy an array
  * \param array The array to destroy
@@ -0,0 +1,381 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "SSGE_local.h"
+#include "SSGE/SSGE_atlas.h"
+
+#define _ENTRIES_INITIAL_SIZE   16
+#define _PADDING                1
+
+// A segment of the skyline of a page
+typedef struct _SkylineNode {
+    int x;
+    int y;
+    int width;
+} _SkylineNode;
+
+// The skyline of a page being packed
+typedef struct _Skyline {
+    _SkylineNode    *nodes;
+    uint32_t        count;
+    int             width;
+    int             height;
+    bool            full;   // Pages holding an oversized texture are not packed further
+} _Skyline;
+
+static void _addEntry(SSGE_Atlas *atlas, SSGE_Texture *texture, SDL_Texture *source, SDL_Surface *surface, SDL_Rect src, bool ownsSource) {
+    if (atlas->built)
+        SSGE_Error("Atlas already built")
+
+    if (atlas->count == atlas->size) {
+        uint32_t size = atlas->size ? atlas->size * 2 : _ENTRIES_INITIAL_SIZE;
+        _SSGE_AtlasEntry *entries = (_SSGE_AtlasEntry *)realloc(atlas->entries, sizeof(_SSGE_AtlasEntry) * size);
+        if (entries == NULL)
+            SSGE_Error("Failed to allocate memory for atlas")
+        atlas->entries = entries;
+        atlas->size = size;
+    }
+
+    atlas->entries[atlas->count++] = (_SSGE_AtlasEntry){
+        .texture = texture,
+        .source = source,
+        .surface = surface,
+        .src = src,
+        .ownsSource = ownsSource,
+        .page = 0
+    };
+    ++atlas->refs;
+
+    // Until the atlas is built, the texture is drawn from its source
+    texture->texture = source;
+    texture->src = src;
+    texture->atlas = atlas;
+}
+
+SSGEAPI SSGE_Atlas *SSGE_Atlas_Create(uint16_t pageWidth, uint16_t pageHeight) {
+    if (pageWidth == 0 || pageHeight == 0)
+        SSGE_Error("Invalid atlas page size")
+
+    SSGE_Atlas *atlas = (SSGE_Atlas *)malloc(sizeof(SSGE_Atlas));
+    if (atlas == NULL)
+        SSGE_Error("Failed to allocate memory for atlas")
+
+    atlas->pageWidth = pageWidth;
+    atlas->pageHeight = pageHeight;
+    atlas->entries = NULL;
+    atlas->count = 0;
+    atlas->size = 0;
+    atlas->pages = NULL;
+    atlas->pageCount = 0;
+    atlas->refs = 1; // Held by the builder until `SSGE_Atlas_Build`
+    atlas->built = false;
+    atlas->drawnFrame = 0;
+    return atlas;
+}
+
+SSGEAPI SSGE_Texture *SSGE_Atlas_AddImage(SSGE_Atlas *atlas, uint32_t *id, const char *name, const char *filename) {
+    // The image is kept so its page can be a static texture, a render target loses its pixels when the targets are reset
+    SDL_Surface *surface = IMG_Load(filename);
+    if (surface == NULL)
+        SSGE_ErrorEx("Failed to load image: %s", IMG_GetError())
+
+    SDL_Texture *source = SDL_CreateTextureFromSurface(_engine.renderer, surface);
+    if (source == NULL)
+        SSGE_ErrorEx("Failed to create texture: %s", SDL_GetError())
+
+    SDL_Rect src = {0, 0, surface->w, surface->h};
+
+    SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
+    if (texture == NULL)
+        SSGE_Error("Failed to allocate memory for texture")
+
+    _initTextureFields(texture);
+    _addEntry(atlas, texture, source, surface, src, true);
+
+    _addToList(&_textureList, texture, name, id, __func__);
+    return texture;
+}
+
+SSGEAPI SSGE_Texture *SSGE_Atlas_AddTile(SSGE_Atlas *atlas, uint32_t *id, const char *name, SSGE_Tilemap *tilemap, uint16_t row, uint16_t col) {
+    if (row >= tilemap->nbRows || col >= tilemap->nbCols)
+        SSGE_ErrorEx2("Tile out of bounds (row: %u col: %u)", row, col)
+
+    SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
+    if (texture == NULL)
+        SSGE_Error("Failed to allocate memory for texture")
+
+    SDL_Rect src = {col * (tilemap->tileWidth + tilemap->spacing), row * (tilemap->tileHeight + tilemap->spacing), tilemap->tileWidth, tilemap->tileHeight};
+
+    _initTextureFields(texture);
+    _addEntry(atlas, texture, tilemap->texture, NULL, src, false);
+
+    _addToList(&_textureList, texture, name, id, __func__);
+    return texture;
+}
+
+SSGEAPI void SSGE_Atlas_AddTexture(SSGE_Atlas *atlas, SSGE_Texture *texture) {
+    if (texture->atlas != NULL)
+        SSGE_Error("Texture already in an atlas")
+
+    SDL_Rect src = {0, 0, 0, 0};
+    SDL_QueryTexture(texture->texture, NULL, NULL, &src.w, &src.h);
+
+    _addEntry(atlas, texture, texture->texture, NULL, src, true);
+}
+
+static int _compareHeight(const void *a, const void *b) {
+    const _SSGE_AtlasEntry *ea = (const _SSGE_AtlasEntry *)a;
+    const _SSGE_AtlasEntry *eb = (const _SSGE_AtlasEntry *)b;
+    if ((ea->surface == NULL) != (eb->surface == NULL)) return ea->surface == NULL ? 1 : -1;
+    if (ea->src.h != eb->src.h) return eb->src.h - ea->src.h;
+    return eb->src.w - ea->src.w;
+}
+
+static int _comparePage(const void *a, const void *b) {
+    const _SSGE_AtlasEntry *ea = (const _SSGE_AtlasEntry *)a;
+    const _SSGE_AtlasEntry *eb = (const _SSGE_AtlasEntry *)b;
+    if (ea->page != eb->page) return ea->page < eb->page ? -1 : 1;
+    if (ea->texture->src.y != eb->texture->src.y) return ea->texture->src.y - eb->texture->src.y;
+    return ea->texture->src.x - eb->texture->src.x;
+}
+
+/**
+ * Finds the lowest position of a rect on a skyline
+ * \param skyline The skyline
+ * \param width The width of the rect
+ * \param height The height of the rect
+ * \param x Where to store the x coordinate
+ * \param y Where to store the y coordinate
+ * \return The node the rect starts at, or -1 if the rect does not fit
+ */
+static int _skylineFind(_Skyline *skyline, int width, int height, int *x, int *y) {
+    int best = -1, bestY = skyline->height, bestX = 0;
+
+    for (uint32_t i = 0; i < skyline->count; i++) {
+        int left = skyline->nodes[i].x;
+        if (left + width > skyline->width) break;
+
+        // The rect rests on the highest node it spans
+        int top = 0;
+        for (uint32_t j = i; j < skyline->count && skyline->nodes[j].x < left + width; j++)
+            if (skyline->nodes[j].y > top) top = skyline->nodes[j].y;
+
+        if (top + height > skyline->height || top >= bestY) continue;
+        best = (int)i;
+        bestY = top;
+        bestX = left;
+    }
+
+    *x = bestX;
+    *y = bestY;
+    return best;
+}
+
+/**
+ * Places a rect on a skyline
+ * \param skyline The skyline
+ * \param index The node returned by `_skylineFind`
+ * \param x The x coordinate of the rect
+ * \param y The y coordinate of the rect
+ * \param width The width of the rect
+ * \param height The height of the rect
+ */
+static void _skylinePlace(_Skyline *skyline, int index, int x, int y, int width, int height) {
+    memmove(&skyline->nodes[index + 1], &skyline->nodes[index], sizeof(_SkylineNode) * (skyline->count - index));
+    skyline->nodes[index] = (_SkylineNode){x, y + height, width};
+    ++skyline->count;
+
+    // Shrink or remove the nodes covered by the rect
+    uint32_t i = index + 1;
+    while (i < skyline->count) {
+        _SkylineNode *node = &skyline->nodes[i];
+        int right = x + width;
+        if (node->x >= right) break;
+        if (node->x + node->width <= right) {
+            memmove(node, node + 1, sizeof(_SkylineNode) * (skyline->count - i - 1));
+            --skyline->count;
+            continue;
+        }
+        node->width -= right - node->x;
+        node->x = right;
+        break;
+    }
+
+    // Merge the neighbours at the same height
+    for (i = 0; i + 1 < skyline->count;) {
+        if (skyline->nodes[i].y == skyline->nodes[i + 1].y) {
+            skyline->nodes[i].width += skyline->nodes[i + 1].width;
+            memmove(&skyline->nodes[i + 1], &skyline->nodes[i + 2], sizeof(_SkylineNode) * (skyline->count - i - 2));
+            --skyline->count;
+        } else ++i;
+    }
+}
+
+static void _skylineOpen(_Skyline *skyline, int width, int height, uint32_t capacity, bool full) {
+    skyline->nodes = (_SkylineNode *)malloc(sizeof(_SkylineNode) * capacity);
+    if (skyline->nodes == NULL)
+        SSGE_Error("Failed to allocate memory for atlas")
+    skyline->nodes[0] = (_SkylineNode){0, 0, width};
+    skyline->count = 1;
+    skyline->width = width;
+    skyline->height = height;
+    skyline->full = full;
+}
+
+SSGEAPI void SSGE_Atlas_Build(SSGE_Atlas *atlas) {
+    if (atlas->built)
+        SSGE_Error("Atlas already built")
+
+    if (atlas->count == 0) {
+        free(atlas->entries);
+        free(atlas);
+        return;
+    }
+
+    // Tallest first packs a skyline the tightest, the images are packed first on pages of their own
+    qsort(atlas->entries, atlas->count, sizeof(_SSGE_AtlasEntry), _compareHeight);
+
+    // Each placement adds at most two nodes to a skyline
+    uint32_t capacity = atlas->count * 2 + 1;
+    _Skyline *skylines = (_Skyline *)malloc(sizeof(_Skyline) * atlas->count);
+    if (skylines == NULL)
+        SSGE_Error("Failed to allocate memory for atlas")
+    uint32_t pageCount = 0, firstPage = 0;
+
+    for (uint32_t i = 0; i < atlas->count; i++) {
+        _SSGE_AtlasEntry *entry = &atlas->entries[i];
+        int width = entry->src.w + _PADDING, height = entry->src.h + _PADDING;
+        int x = 0, y = 0;
+
+        // The other textures don't share the pages of the images
+        if (entry->surface == NULL && i > 0 && atlas->entries[i - 1].surface != NULL)
+            firstPage = pageCount;
+
+        if (width > atlas->pageWidth || height > atlas->pageHeight) {
+            // Too large for a page, give it its own
+            _skylineOpen(&skylines[pageCount], entry->src.w, entry->src.h, 1, true);
+            entry->page = pageCount++;
+        } else {
+            uint32_t page = firstPage;
+            int index = -1;
+            for (; page < pageCount; page++) {
+                if (skylines[page].full) continue;
+                index = _skylineFind(&skylines[page], width, height, &x, &y);
+                if (index != -1) break;
+            }
+            if (index == -1) {
+                page = pageCount++;
+                _skylineOpen(&skylines[page], atlas->pageWidth, atlas->pageHeight, capacity, false);
+                index = _skylineFind(&skylines[page], width, height, &x, &y);
+            }
+            _skylinePlace(&skylines[page], index, x, y, width, height);
+            entry->page = page;
+        }
+
+        // The destination rect is kept in the texture until the sources are copied
+        entry->texture->src = (SDL_Rect){x, y, entry->src.w, entry->src.h};
+    }
+    uint32_t imagePages = atlas->entries[atlas->count - 1].surface != NULL ? pageCount : firstPage;
+
+    atlas->pages = (SDL_Texture **)malloc(sizeof(SDL_Texture *) * pageCount);
+    SDL_Surface **surfaces = (SDL_Surface **)malloc(sizeof(SDL_Surface *) * (imagePages ? imagePages : 1));
+    if (atlas->pages == NULL || surfaces == NULL)
+        SSGE_Error("Failed to allocate memory for atlas")
+
+    // The pages of images are static textures built from a surface, they survive a reset of the render targets
+    for (uint32_t page = 0; page < imagePages; page++) {
+        surfaces[page] = SDL_CreateRGBSurfaceWithFormat(0, skylines[page].width, skylines[page].height, 32, SDL_PIXELFORMAT_RGBA32);
+        if (surfaces[page] == NULL)
+            SSGE_ErrorEx("Failed to create atlas page: %s", SDL_GetError())
+    }
+
+    // The other textures can only be read by the renderer, their pages are render targets
+    SDL_Texture *target = SDL_GetRenderTarget(_engine.renderer);
+    for (uint32_t page = imagePages; page < pageCount; page++) {
+        SDL_Texture *texture = SDL_CreateTexture(_engine.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, skylines[page].width, skylines[page].height);
+        if (texture == NULL)
+            SSGE_ErrorEx("Failed to create atlas page: %s", SDL_GetError())
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderTarget(_engine.renderer, texture);
+        SDL_SetRenderDrawColor(_engine.renderer, 0, 0, 0, 0);
+        SDL_RenderClear(_engine.renderer);
+        atlas->pages[page] = texture;
+    }
+    for (uint32_t page = 0; page < pageCount; page++)
+        free(skylines[page].nodes);
+    atlas->pageCount = pageCount;
+    free(skylines);
+
+    // Copy the pixels as they are, alpha included
+    for (uint32_t i = 0; i < atlas->count; i++) {
+        _SSGE_AtlasEntry *entry = &atlas->entries[i];
+        if (entry->surface != NULL) {
+            SDL_Rect dest = entry->texture->src; // Overwritten by the blit
+            SDL_SetSurfaceBlendMode(entry->surface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(entry->surface, &entry->src, surfaces[entry->page], &dest);
+            continue;
+        }
+
+        SDL_BlendMode mode;
+        SDL_SetRenderTarget(_engine.renderer, atlas->pages[entry->page]);
+        SDL_GetTextureBlendMode(entry->source, &mode);
+        SDL_SetTextureBlendMode(entry->source, SDL_BLENDMODE_NONE);
+        SDL_RenderCopy(_engine.renderer, entry->source, &entry->src, &entry->texture->src);
+        SDL_SetTextureBlendMode(entry->source, mode);
+    }
+    SDL_SetRenderTarget(_engine.renderer, target);
+    SDL_SetRenderDrawColor(_engine.renderer, _color.r, _color.g, _color.b, _color.a);
+
+    for (uint32_t page = 0; page < imagePages; page++) {
+        atlas->pages[page] = SDL_CreateTextureFromSurface(_engine.renderer, surfaces[page]);
+        if (atlas->pages[page] == NULL)
+            SSGE_ErrorEx("Failed to create atlas page: %s", SDL_GetError())
+        SDL_SetTextureBlendMode(atlas->pages[page], SDL_BLENDMODE_BLEND);
+        SDL_FreeSurface(surfaces[page]);
+    }
+    free(surfaces);
+
+    for (uint32_t i = 0; i < atlas->count; i++)
+        atlas->entries[i].texture->texture = atlas->pages[atlas->entries[i].page];
+
+    for (uint32_t i = 0; i < atlas->count; i++) {
+        _SSGE_AtlasEntry *entry = &atlas->entries[i];
+        if (entry->ownsSource) SDL_DestroyTexture(entry->source);
+        SDL_FreeSurface(entry->surface);
+        entry->source = NULL;
+        entry->surface = NULL;
+        entry->ownsSource = false;
+    }
+
+    // Consecutive entries share a page, so the draws of a page follow each other
+    qsort(atlas->entries, atlas->count, sizeof(_SSGE_AtlasEntry), _comparePage);
+    atlas->built = true;
+    --atlas->refs;
+    invalidateLayers(); // The textures of the atlas are now drawn from its pages
+}
+
+/**
+ * Removes a texture from its atlas, freeing the atlas with its last texture
+ * \param texture The texture
+ */
+void removeFromAtlas(SSGE_Texture *texture) {
+    SSGE_Atlas *atlas = texture->atlas;
+
+    for (uint32_t i = 0; i < atlas->count; i++) {
+        if (atlas->entries[i].texture != texture) continue;
+        if (atlas->entries[i].ownsSource) SDL_DestroyTexture(atlas->entries[i].source);
+        SDL_FreeSurface(atlas->entries[i].surface);
+        memmove(&atlas->entries[i], &atlas->entries[i + 1], sizeof(_SSGE_AtlasEntry) * (atlas->count - i - 1));
+        --atlas->count;
+        break;
+    }
+    texture->atlas = NULL;
+
+    if (--atlas->refs > 0) return;
+
+    for (uint32_t i = 0; i < atlas->pageCount; i++)
+        SDL_DestroyTexture(atlas->pages[i]);
+    free(atlas->pages);
+    free(atlas->entries);
+    free(atlas);
+}
@@ -1,7 +1,12 @@
 #include "SSGE_local.h"
 #include "SSGE/SSGE_audio.h"
+#include "SSGE/SSGE_trace.h"
 
 SSGEAPI SSGE_Audio *SSGE_Audio_Create(uint32_t *id, const char *name, const char *filename) {
+    if (!_engine.audio)
+        SSGE_Error("Audio is disabled")
+
+    SSGE_Trace_Begin(__func__);
     SSGE_Audio *audio = (SSGE_Audio *)malloc(sizeof(SSGE_Audio));
     if (audio == NULL) 
         SSGE_Error("Failed to allocate memory for audio")
@@ -11,6 +16,7 @@ SSGEAPI SSGE_Audio *SSGE_Audio_Create(uint32_t *id, const char *name, const char
         SSGE_ErrorEx("Failed to load audio: %s", Mix_GetError());
 
     _addToList(&_audioList, audio, name, id, __func__);
+    SSGE_Trace_End();
     return audio;
 }
 
@@ -21,12 +27,8 @@ SSGEAPI SSGE_Audio *SSGE_Audio_Get(uint32_t id) {
     return ptr;
 }
 
-inline static bool _find_audio_name(void *ptr, void *name) {
-    return strcmp(((SSGE_Audio *)ptr)->name, (char *)name) == 0;
-}
-
 SSGEAPI SSGE_Audio *SSGE_Audio_GetName(const char *name) {
-    SSGE_Audio *ptr = (SSGE_Audio *)SSGE_Array_Find(&_audioList, _find_audio_name, (void *)name);
+    SSGE_Audio *ptr = (SSGE_Audio *)SSGE_Array_GetName(&_audioList, name);
     if (ptr == NULL) 
         SSGE_ErrorEx("Audio not found: %s", name)
     return ptr;
@@ -60,7 +62,7 @@ SSGEAPI void SSGE_Audio_Close(uint32_t id) {
 }
 
 SSGEAPI void SSGE_Audio_CloseName(const char *name) {
-    SSGE_Audio *audio = SSGE_Array_FindPop(&_audioList, _find_audio_name, (void *)name);
+    SSGE_Audio *audio = SSGE_Array_PopName(&_audioList, name);
     if (audio == NULL) 
         SSGE_ErrorEx("Audio not found: %s", name)
     destroyAudio(audio);
@@ -68,5 +70,6 @@ SSGEAPI void SSGE_Audio_CloseName(const char *name) {
 
 SSGEAPI void SSGE_Audio_CloseAll() {
     SSGE_Array_Destroy(&_audioList, (SSGE_DestroyData)destroyAudio);
-    SSGE_Array_Create(&_audioList);
+    SSGE_Array_CreateSlotMap(&_audioList, _LIST_INITIAL_SIZE);
+    SSGE_Array_IndexNames(&_audioList);
 }
@@ -0,0 +1,170 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "SSGE_local.h"
+#include "SSGE_error.h"
+
+#define _BATCH_INITIAL_SIZE 64
+#define _GROWTH_FACTOR      2
+#define _DEG_TO_RAD         0.017453292519943295
+
+/**
+ * Create a sprite batch
+ * \param batch The sprite batch to initialize
+ * \param renderer The renderer the batch is submitted to
+ * \note Batching is disabled on the software renderer, sprites are then copied one by one
+ */
+SSGEAPI void SSGE_SpriteBatch_Create(_SSGE_SpriteBatch *batch, SDL_Renderer *renderer) {
+    SDL_RendererInfo info;
+    batch->renderer = renderer;
+    batch->enabled = SDL_GetRendererInfo(renderer, &info) == 0
+        && !(info.flags & SDL_RENDERER_SOFTWARE)
+        && strcmp(info.name, "software") != 0;
+    batch->texture = NULL;
+    batch->scale = 1;
+    batch->offsetX = 0;
+    batch->offsetY = 0;
+    batch->vertices = NULL;
+    batch->indices = NULL;
+    batch->count = 0;
+    batch->size = 0;
+}
+
+static void _grow(_SSGE_SpriteBatch *batch) {
+    uint32_t size = batch->size ? batch->size * _GROWTH_FACTOR : _BATCH_INITIAL_SIZE;
+
+    SDL_Vertex *vertices = (SDL_Vertex *)realloc(batch->vertices, sizeof(SDL_Vertex) * 4 * size);
+    if (vertices == NULL)
+        SSGE_Error("Failed to allocate memory for sprite batch")
+    batch->vertices = vertices;
+
+    int *indices = (int *)realloc(batch->indices, sizeof(int) * 6 * size);
+    if (indices == NULL)
+        SSGE_Error("Failed to allocate memory for sprite batch")
+    batch->indices = indices;
+
+    batch->size = size;
+}
+
+/**
+ * Set the transform applied to the sprites of a sprite batch, `screen = position * scale + offset`
+ * \param batch The sprite batch
+ * \param scale The scale
+ * \param offsetX The x offset
+ * \param offsetY The y offset
+ */
+SSGEAPI void SSGE_SpriteBatch_SetTransform(_SSGE_SpriteBatch *batch, float scale, float offsetX, float offsetY) {
+    SSGE_SpriteBatch_Flush(batch);
+    batch->scale = scale;
+    batch->offsetX = offsetX;
+    batch->offsetY = offsetY;
+}
+
+/**
+ * Queue a sprite in a sprite batch
+ * \param batch The sprite batch
+ * \param texture The texture of the sprite
+ * \param src The source rect in the texture, NULL for the whole texture
+ * \param data The render data of the sprite
+ * \note The batch is flushed first if the texture differs from the queued sprites
+ */
+SSGEAPI void SSGE_SpriteBatch_Push(_SSGE_SpriteBatch *batch, SDL_Texture *texture, const SDL_Rect *src, const _SSGE_RenderData *data) {
+    if (!batch->enabled) {
+        float scale = batch->scale;
+        int x0 = (int)lroundf((float)data->dest.x * scale + batch->offsetX), y0 = (int)lroundf((float)data->dest.y * scale + batch->offsetY);
+        int x1 = (int)lroundf((float)(data->dest.x + data->dest.w) * scale + batch->offsetX), y1 = (int)lroundf((float)(data->dest.y + data->dest.h) * scale + batch->offsetY);
+        SDL_Rect dest = {x0, y0, x1 - x0, y1 - y0};
+        SDL_Point center = {(int)lroundf((float)data->rotationCenter.x * scale), (int)lroundf((float)data->rotationCenter.y * scale)};
+
+        if (data->angle == 0 && data->flip == 0) SDL_RenderCopy(batch->renderer, texture, src, &dest);
+        else SDL_RenderCopyEx(batch->renderer, texture, src, &dest, data->angle, &center, (SDL_RendererFlip)data->flip);
+        return;
+    }
+
+    if (batch->texture != texture) {
+        SSGE_SpriteBatch_Flush(batch);
+
+        int width, height;
+        SDL_QueryTexture(texture, NULL, NULL, &width, &height);
+        batch->texture = texture;
+        batch->invWidth = 1.0f / (float)width;
+        batch->invHeight = 1.0f / (float)height;
+
+        // Vertex colors replace the texture modulation
+        SDL_GetTextureColorMod(texture, &batch->color.r, &batch->color.g, &batch->color.b);
+        SDL_GetTextureAlphaMod(texture, &batch->color.a);
+    }
+    if (batch->count == batch->size) _grow(batch);
+
+    float u0 = 0, v0 = 0, u1 = 1, v1 = 1;
+    if (src != NULL) {
+        u0 = (float)src->x * batch->invWidth;
+        v0 = (float)src->y * batch->invHeight;
+        u1 = (float)(src->x + src->w) * batch->invWidth;
+        v1 = (float)(src->y + src->h) * batch->invHeight;
+    }
+    if (data->flip & SSGE_FLIP_HORIZONTAL) { float u = u0; u0 = u1; u1 = u; }
+    if (data->flip & SSGE_FLIP_VERTICAL) { float v = v0; v0 = v1; v1 = v; }
+
+    float x0 = (float)data->dest.x, y0 = (float)data->dest.y;
+    float x1 = x0 + (float)data->dest.w, y1 = y0 + (float)data->dest.h;
+    SDL_FPoint corners[4] = {{x0, y0}, {x1, y0}, {x1, y1}, {x0, y1}};
+
+    if (data->angle != 0) {
+        // Clockwise around the rotation center, like SDL_RenderCopyEx
+        float px = x0 + (float)data->rotationCenter.x, py = y0 + (float)data->rotationCenter.y;
+        float c = (float)cos(data->angle * _DEG_TO_RAD), s = (float)sin(data->angle * _DEG_TO_RAD);
+        for (int i = 0; i < 4; i++) {
+            float dx = corners[i].x - px, dy = corners[i].y - py;
+            corners[i].x = px + dx * c - dy * s;
+            corners[i].y = py + dx * s + dy * c;
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        corners[i].x = corners[i].x * batch->scale + batch->offsetX;
+        corners[i].y = corners[i].y * batch->scale + batch->offsetY;
+    }
+
+    SDL_Vertex *vertex = &batch->vertices[batch->count * 4];
+    vertex[0] = (SDL_Vertex){corners[0], batch->color, {u0, v0}};
+    vertex[1] = (SDL_Vertex){corners[1], batch->color, {u1, v0}};
+    vertex[2] = (SDL_Vertex){corners[2], batch->color, {u1, v1}};
+    vertex[3] = (SDL_Vertex){corners[3], batch->color, {u0, v1}};
+
+    int base = (int)batch->count * 4;
+    int *index = &batch->indices[batch->count * 6];
+    index[0] = base;
+    index[1] = base + 1;
+    index[2] = base + 2;
+    index[3] = base;
+    index[4] = base + 2;
+    index[5] = base + 3;
+
+    ++batch->count;
+}
+
+/**
+ * Submit the queued sprites of a sprite batch
+ * \param batch The sprite batch
+ */
+SSGEAPI void SSGE_SpriteBatch_Flush(_SSGE_SpriteBatch *batch) {
+    if (batch->count != 0)
+        SDL_RenderGeometry(batch->renderer, batch->texture, batch->vertices, (int)batch->count * 4, batch->indices, (int)batch->count * 6);
+    batch->count = 0;
+    batch->texture = NULL;
+}
+
+/**
+ * Destroy a sprite batch
+ * \param batch The sprite batch to destroy
+ */
+SSGEAPI void SSGE_SpriteBatch_Destroy(_SSGE_SpriteBatch *batch) {
+    free(batch->vertices);
+    free(batch->indices);
+    batch->vertices = NULL;
+    batch->indices = NULL;
+    batch->count = 0;
+    batch->size = 0;
+    batch->texture = NULL;
+}
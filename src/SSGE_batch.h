@@ -0,0 +1,62 @@
+// Internal sprite batch functions
+
+#ifndef __SSGE_BATCH_H__
+#define __SSGE_BATCH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern _SSGE_SpriteBatch _spriteBatch;
+
+/**
+ * Create a sprite batch
+ * \param batch The sprite batch to initialize
+ * \param renderer The renderer the batch is submitted to
+ * \note Batching is disabled on the software renderer, sprites are then copied one by one
+ */
+SSGEAPI void SSGE_SpriteBatch_Create(_SSGE_SpriteBatch *batch, SDL_Renderer *renderer);
+
+/**
+ * Set the transform applied to the sprites of a sprite batch, `screen = position * scale + offset`
+ * \param batch The sprite batch
+ * \param scale The scale
+ * \param offsetX The x offset
+ * \param offsetY The y offset
+ * \note The batch is flushed first
+ */
+SSGEAPI void SSGE_SpriteBatch_SetTransform(_SSGE_SpriteBatch *batch, float scale, float offsetX, float offsetY);
+
+/**
+ * Queue a sprite in a sprite batch
+ * \param batch The sprite batch
+ * \param texture The texture of the sprite
+ * \param src The source rect in the texture, NULL for the whole texture
+ * \param data The render data of the sprite
+ * \note The batch is flushed first if the texture differs from the queued sprites
+ */
+SSGEAPI void SSGE_SpriteBatch_Push(_SSGE_SpriteBatch *batch, SDL_Texture *texture, const SDL_Rect *src, const _SSGE_RenderData *data);
+
+/**
+ * Submit the queued sprites of a sprite batch
+ * \param batch The sprite batch
+ */
+SSGEAPI void SSGE_SpriteBatch_Flush(_SSGE_SpriteBatch *batch);
+
+/**
+ * Destroy a sprite batch
+ * \param batch The sprite batch to destroy
+ */
+SSGEAPI void SSGE_SpriteBatch_Destroy(_SSGE_SpriteBatch *batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_BATCH_H__
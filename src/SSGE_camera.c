@@ -0,0 +1,121 @@
+#include <math.h>
+
+#include "SSGE_local.h"
+#include "SSGE/SSGE_camera.h"
+
+SSGEAPI void SSGE_Camera_SetPosition(int x, int y) {
+    if (x == _camera.x && y == _camera.y) return;
+    _camera.x = x;
+    _camera.y = y;
+    invalidateLayers();
+    if (_engine.partialRedraw) SSGE_Damage_AddAll(&_damage);
+}
+
+SSGEAPI void SSGE_Camera_Move(int dx, int dy) {
+    SSGE_Camera_SetPosition(_camera.x + dx, _camera.y + dy);
+}
+
+SSGEAPI void SSGE_Camera_SetZoom(float zoom) {
+    if (!(zoom > 0))
+        SSGE_Error("Camera zoom must be positive")
+    _camera.zoom = zoom;
+    invalidateLayers();
+    if (_engine.partialRedraw) SSGE_Damage_AddAll(&_damage);
+}
+
+SSGEAPI void SSGE_Camera_SetViewport(int x, int y, int width, int height) {
+    _camera.viewport = (SDL_Rect){x, y, width, height};
+    invalidateLayers();
+    if (_engine.partialRedraw) SSGE_Damage_AddAll(&_damage);
+}
+
+SSGEAPI void SSGE_Camera_GetPosition(int *x, int *y) {
+    if (x) *x = _camera.x;
+    if (y) *y = _camera.y;
+}
+
+SSGEAPI float SSGE_Camera_GetZoom() {
+    return _camera.zoom;
+}
+
+SSGEAPI void SSGE_Camera_ScreenToWorld(int x, int y, int *worldX, int *worldY) {
+    SDL_Rect viewport;
+    cameraViewport(&viewport);
+    *worldX = _camera.x + (int)floorf((float)(x - viewport.x) / _camera.zoom);
+    *worldY = _camera.y + (int)floorf((float)(y - viewport.y) / _camera.zoom);
+}
+
+SSGEAPI void SSGE_Camera_WorldToScreen(int x, int y, int *screenX, int *screenY) {
+    SDL_Rect viewport;
+    cameraViewport(&viewport);
+    *screenX = viewport.x + (int)lroundf((float)(x - _camera.x) * _camera.zoom);
+    *screenY = viewport.y + (int)lroundf((float)(y - _camera.y) * _camera.zoom);
+}
+
+/**
+ * Gets the region of the window the camera draws in
+ * \param viewport Where to store the viewport
+ */
+void cameraViewport(SDL_Rect *viewport) {
+    *viewport = _camera.viewport;
+    if (viewport->w == 0) viewport->w = _engine.width - viewport->x;
+    if (viewport->h == 0) viewport->h = _engine.height - viewport->y;
+}
+
+/**
+ * Gets the region of the world seen by the camera
+ * \param view Where to store the region
+ */
+void cameraView(SDL_Rect *view) {
+    SDL_Rect viewport;
+    cameraViewport(&viewport);
+    view->x = _camera.x;
+    view->y = _camera.y;
+    view->w = (int)ceilf((float)viewport.w / _camera.zoom);
+    view->h = (int)ceilf((float)viewport.h / _camera.zoom);
+}
+
+/**
+ * Gets the transform from world to window coordinates, `screen = world * scale + offset`
+ * \param scale Where to store the scale
+ * \param offsetX Where to store the x offset
+ * \param offsetY Where to store the y offset
+ */
+void cameraTransform(float *scale, float *offsetX, float *offsetY) {
+    SDL_Rect viewport;
+    cameraViewport(&viewport);
+    *scale = _camera.zoom;
+    *offsetX = (float)viewport.x - (float)_camera.x * _camera.zoom;
+    *offsetY = (float)viewport.y - (float)_camera.y * _camera.zoom;
+}
+
+/**
+ * Converts a world rect to a window rect
+ * \param rect The rect to convert, in place
+ * \return False if the rect is not seen by the camera
+ */
+bool cameraApply(SDL_Rect *rect) {
+    SDL_Rect view;
+    cameraView(&view);
+    if (rect->x >= view.x + view.w || rect->x + rect->w <= view.x || rect->y >= view.y + view.h || rect->y + rect->h <= view.y)
+        return false;
+
+    float scale, offsetX, offsetY;
+    cameraTransform(&scale, &offsetX, &offsetY);
+    int x0 = (int)lroundf((float)rect->x * scale + offsetX), y0 = (int)lroundf((float)rect->y * scale + offsetY);
+    int x1 = (int)lroundf((float)(rect->x + rect->w) * scale + offsetX), y1 = (int)lroundf((float)(rect->y + rect->h) * scale + offsetY);
+    *rect = (SDL_Rect){x0, y0, x1 - x0, y1 - y0};
+    return true;
+}
+
+/**
+ * Converts a window rect to the smallest world rect covering it
+ * \param rect The rect to convert, in place
+ */
+void cameraUnapply(SDL_Rect *rect) {
+    float scale, offsetX, offsetY;
+    cameraTransform(&scale, &offsetX, &offsetY);
+    int x0 = (int)floorf(((float)rect->x - offsetX) / scale), y0 = (int)floorf(((float)rect->y - offsetY) / scale);
+    int x1 = (int)ceilf(((float)(rect->x + rect->w) - offsetX) / scale), y1 = (int)ceilf(((float)(rect->y + rect->h) - offsetY) / scale);
+    *rect = (SDL_Rect){x0, y0, x1 - x0, y1 - y0};
+}
@@ -0,0 +1,169 @@
+#include <stdlib.h>
+#include <math.h>
+
+#include "SSGE_local.h"
+#include "SSGE_error.h"
+
+// Regions this close are merged, so the list rarely fills up and falls back to the whole window
+#define _MERGE_DISTANCE 8
+
+static inline bool _near(const SDL_Rect *a, const SDL_Rect *b) {
+    return a->x - _MERGE_DISTANCE < b->x + b->w && b->x - _MERGE_DISTANCE < a->x + a->w
+        && a->y - _MERGE_DISTANCE < b->y + b->h && b->y - _MERGE_DISTANCE < a->y + a->h;
+}
+
+static inline void _union(SDL_Rect *a, const SDL_Rect *b) {
+    int x1 = a->x + a->w > b->x + b->w ? a->x + a->w : b->x + b->w;
+    int y1 = a->y + a->h > b->y + b->h ? a->y + a->h : b->y + b->h;
+    if (b->x < a->x) a->x = b->x;
+    if (b->y < a->y) a->y = b->y;
+    a->w = x1 - a->x;
+    a->h = y1 - a->y;
+}
+
+/**
+ * Adds a damaged region to a damage list
+ * \param list The damage list
+ * \param rect The damaged region, clipped to the window
+ */
+SSGEAPI void SSGE_Damage_Add(_SSGE_DamageList *list, const SDL_Rect *rect) {
+    if (list->full) return;
+
+    // Clip to the window
+    int x0 = rect->x < 0 ? 0 : rect->x;
+    int y0 = rect->y < 0 ? 0 : rect->y;
+    int x1 = rect->x + rect->w > _engine.width ? _engine.width : rect->x + rect->w;
+    int y1 = rect->y + rect->h > _engine.height ? _engine.height : rect->y + rect->h;
+    if (x1 <= x0 || y1 <= y0) return;
+    SDL_Rect damage = {x0, y0, x1 - x0, y1 - y0};
+
+    // Grow the region until it no longer touches another one
+    for (uint32_t i = 0; i < list->count;) {
+        if (!_near(&damage, &list->rects[i])) {
+            ++i;
+            continue;
+        }
+        _union(&damage, &list->rects[i]);
+        list->rects[i] = list->rects[--list->count];
+        i = 0;
+    }
+
+    if (list->count == _SSGE_DAMAGE_MAX_RECTS || (int64_t)damage.w * damage.h * 2 > (int64_t)_engine.width * _engine.height) {
+        SSGE_Damage_AddAll(list);
+        return;
+    }
+    list->rects[list->count++] = damage;
+}
+
+/**
+ * Damages the whole window
+ * \param list The damage list
+ */
+SSGEAPI void SSGE_Damage_AddAll(_SSGE_DamageList *list) {
+    list->rects[0] = (SDL_Rect){0, 0, _engine.width, _engine.height};
+    list->count = 1;
+    list->full = true;
+}
+
+/**
+ * Checks if a damage list is empty
+ * \param list The damage list
+ * \return True if nothing is damaged
+ */
+SSGEAPI bool SSGE_Damage_IsEmpty(const _SSGE_DamageList *list) {
+    return list->count == 0;
+}
+
+/**
+ * Gets the bounding box of the damaged regions of a damage list
+ * \param list The damage list, not empty
+ * \param rect The bounding box
+ */
+SSGEAPI void SSGE_Damage_GetBounds(const _SSGE_DamageList *list, SDL_Rect *rect) {
+    *rect = list->rects[0];
+    for (uint32_t i = 1; i < list->count; i++)
+        _union(rect, &list->rects[i]);
+}
+
+/**
+ * Empties a damage list
+ * \param list The damage list
+ */
+SSGEAPI void SSGE_Damage_Clear(_SSGE_DamageList *list) {
+    list->count = 0;
+    list->full = false;
+}
+
+/**
+ * Marks a region of the world to be redrawn, if the partial redraw mode is enabled
+ * \param x The x coordinate of the region
+ * \param y The y coordinate of the region
+ * \param width The width of the region
+ * \param height The height of the region
+ */
+void markDamage(int x, int y, int width, int height) {
+    if (!_engine.partialRedraw) return;
+
+    // Damage is tracked in window coordinates
+    SDL_Rect rect = {x, y, width, height};
+    if (cameraApply(&rect))
+        SSGE_Damage_Add(&_damage, &rect);
+}
+
+/**
+ * Marks the region covered by a persistent render data to be redrawn, with the cache of its layer if it is static
+ * \param data The render data
+ */
+void markRenderDamage(const _SSGE_RenderData *data) {
+    if (_staticLayers.count != 0) invalidateLayer(data->layer);
+    markDrawDamage(data);
+}
+
+/**
+ * Marks the region covered by a one-shot render data to be redrawn
+ * \param data The render data
+ * \note One-shot render data are never cached by the static layers, their caches stay valid
+ */
+void markDrawDamage(const _SSGE_RenderData *data) {
+    if (!_engine.partialRedraw) return;
+    if (data->angle == 0) {
+        markDamage(data->dest.x, data->dest.y, data->dest.w, data->dest.h);
+        return;
+    }
+
+    // Any rotation stays in the circle around the rotation center reaching the farthest corner
+    int cx = data->dest.x + data->rotationCenter.x, cy = data->dest.y + data->rotationCenter.y;
+    int dx = abs(data->rotationCenter.x) > abs(data->dest.w - data->rotationCenter.x) ? abs(data->rotationCenter.x) : abs(data->dest.w - data->rotationCenter.x);
+    int dy = abs(data->rotationCenter.y) > abs(data->dest.h - data->rotationCenter.y) ? abs(data->rotationCenter.y) : abs(data->dest.h - data->rotationCenter.y);
+    int radius = (int)ceil(sqrt((double)dx * dx + (double)dy * dy));
+    markDamage(cx - radius, cy - radius, radius * 2 + 1, radius * 2 + 1);
+}
+
+/**
+ * Marks the region covered by an animation state to be redrawn
+ * \param state The animation state
+ * \note Function animations may draw anywhere, they damage the whole window
+ * \note A shared animation state damages the regions of all its instances
+ */
+void markAnimationDamage(const SSGE_AnimationState *state) {
+    if (!_engine.partialRedraw) return;
+    SSGE_Animation *anim = state->animation;
+    if (anim->type != SSGE_ANIM_FRAMES)
+        SSGE_Damage_AddAll(&_damage);
+    else if (state->clock == NULL)
+        markDamage(state->x - anim->data.anchorX, state->y - anim->data.anchorY, anim->data.width, anim->data.height);
+    else
+        for (uint32_t i = 0; i < state->clock->count; i++)
+            markInstanceDamage(state, &state->clock->instances[i]);
+}
+
+/**
+ * Marks the region covered by an instance of a shared animation state to be redrawn
+ * \param state The shared animation state
+ * \param instance The instance
+ */
+void markInstanceDamage(const SSGE_AnimationState *state, const _SSGE_AnimationInstance *instance) {
+    if (!_engine.partialRedraw) return;
+    struct _SSGE_AnimationData *anim = &state->animation->data;
+    markDamage(instance->x - anim->anchorX, instance->y - anim->anchorY, anim->width, anim->height);
+}
@@ -0,0 +1,56 @@
+// Internal damage tracking functions
+
+#ifndef __SSGE_DAMAGE_H__
+#define __SSGE_DAMAGE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern _SSGE_DamageList _damage;
+
+/**
+ * Add a damaged region to a damage list
+ * \param list The damage list
+ * \param rect The damaged region, clipped to the window
+ * \note Overlapping regions are merged, the whole window is damaged once the list is full
+ */
+SSGEAPI void SSGE_Damage_Add(_SSGE_DamageList *list, const SDL_Rect *rect);
+
+/**
+ * Damage the whole window
+ * \param list The damage list
+ */
+SSGEAPI void SSGE_Damage_AddAll(_SSGE_DamageList *list);
+
+/**
+ * Check if a damage list is empty
+ * \param list The damage list
+ * \return True if nothing is damaged
+ */
+SSGEAPI bool SSGE_Damage_IsEmpty(const _SSGE_DamageList *list);
+
+/**
+ * Get the bounding box of the damaged regions of a damage list
+ * \param list The damage list, not empty
+ * \param rect The bounding box
+ */
+SSGEAPI void SSGE_Damage_GetBounds(const _SSGE_DamageList *list, SDL_Rect *rect);
+
+/**
+ * Empty a damage list
+ * \param list The damage list
+ */
+SSGEAPI void SSGE_Damage_Clear(_SSGE_DamageList *list);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_DAMAGE_H__
@@ -2,6 +2,7 @@
 
 #include "SSGE_local.h"
 #include "SSGE/SSGE_geometry.h"
+#include "SSGE/SSGE_trace.h"
 
 SSGEAPI void SSGE_DrawLine(int x1, int y1, int x2, int y2, SSGE_Color color) {
     if (color.a == 0) return;
@@ -73,11 +74,12 @@ SSGEAPI void SSGE_FillEllipse(int x, int y, int rx, int ry, SSGE_Color color) {
 
 SSGEAPI void SSGE_DrawGeometry(SSGE_Texture *texture, int x, int y) {
     SDL_Rect rect = {x, y, _engine.width, _engine.height};
-    SDL_RenderCopy(_engine.renderer, texture->texture, NULL, &rect);
+    SDL_RenderCopy(_engine.renderer, texture->texture, _TEXTURE_SRC(texture), &rect);
     SDL_SetRenderDrawColor(_engine.renderer, _color.r, _color.g, _color.b, _color.a);
 }
 
 SSGEAPI SSGE_Texture *SSGE_CreateLine(uint32_t *id, const char *name, uint16_t length, SSGE_Color color) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -98,10 +100,12 @@ SSGEAPI SSGE_Texture *SSGE_CreateLine(uint32_t *id, const char *name, uint16_t l
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
 SSGEAPI SSGE_Texture *SSGE_CreateRect(uint32_t *id, const char *name, uint16_t width, uint16_t height, SSGE_Color color) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -122,10 +126,12 @@ SSGEAPI SSGE_Texture *SSGE_CreateRect(uint32_t *id, const char *name, uint16_t w
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
 SSGEAPI SSGE_Texture *SSGE_CreateCircle(uint32_t *id, const char *name, uint16_t radius, SSGE_Color color) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -146,10 +152,12 @@ SSGEAPI SSGE_Texture *SSGE_CreateCircle(uint32_t *id, const char *name, uint16_t
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
 SSGEAPI SSGE_Texture *SSGE_CreateEllipse(uint32_t *id, const char *name, uint16_t rx, uint16_t ry, SSGE_Color color) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -170,10 +178,12 @@ SSGEAPI SSGE_Texture *SSGE_CreateEllipse(uint32_t *id, const char *name, uint16_
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
 SSGEAPI SSGE_Texture *SSGE_CreateLineThick(uint32_t *id, const char *name, uint16_t length, SSGE_Color color, int thickness) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -194,10 +204,12 @@ SSGEAPI SSGE_Texture *SSGE_CreateLineThick(uint32_t *id, const char *name, uint1
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
 SSGEAPI SSGE_Texture *SSGE_CreateRectThick(uint32_t *id, const char *name, uint16_t width, uint16_t height, SSGE_Color color, int thickness) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -220,10 +232,12 @@ SSGEAPI SSGE_Texture *SSGE_CreateRectThick(uint32_t *id, const char *name, uint1
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
 SSGEAPI SSGE_Texture *SSGE_CreateCircleThick(uint32_t *id, const char *name, uint16_t radius, SSGE_Color color, int thickness) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -244,10 +258,12 @@ SSGEAPI SSGE_Texture *SSGE_CreateCircleThick(uint32_t *id, const char *name, uin
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
 SSGEAPI SSGE_Texture *SSGE_CreateEllipseThick(uint32_t *id, const char *name, uint16_t rx, uint16_t ry, SSGE_Color color, int thickness) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -268,11 +284,13 @@ SSGEAPI SSGE_Texture *SSGE_CreateEllipseThick(uint32_t *id, const char *name, ui
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
 
 SSGEAPI SSGE_Texture *SSGE_CreateFillRect(uint32_t *id, const char *name, uint16_t width, uint16_t height, SSGE_Color color) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -293,10 +311,12 @@ SSGEAPI SSGE_Texture *SSGE_CreateFillRect(uint32_t *id, const char *name, uint16
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
 SSGEAPI SSGE_Texture *SSGE_CreateFillCircle(uint32_t *id, const char *name, uint16_t radius, SSGE_Color color) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -317,10 +337,12 @@ SSGEAPI SSGE_Texture *SSGE_CreateFillCircle(uint32_t *id, const char *name, uint
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
 SSGEAPI SSGE_Texture *SSGE_CreateFillEllipse(uint32_t *id, const char *name, uint16_t rx, uint16_t ry, SSGE_Color color) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -341,5 +363,6 @@ SSGEAPI SSGE_Texture *SSGE_CreateFillEllipse(uint32_t *id, const char *name, uin
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
\ No newline at end of file
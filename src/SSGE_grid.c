@@ -0,0 +1,266 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "SSGE_local.h"
+#include "SSGE_error.h"
+
+#define _CELL_SIZE          128 // World units covered by a cell
+#define _NODES_INITIAL_SIZE 64
+#define _CELLS_INITIAL_SIZE 64
+#define _CELL_INITIAL_SIZE  8
+#define _GROWTH_FACTOR      2
+
+// Cell coordinate of a world coordinate, rounding towards negative infinity
+static inline int32_t _cellOf(int value) {
+    return value >= 0 ? value / _CELL_SIZE : -((-value + _CELL_SIZE - 1) / _CELL_SIZE);
+}
+
+static inline uint32_t _hash(int32_t x, int32_t y) {
+    return (uint32_t)x * 0x9E3779B1u ^ (uint32_t)y * 0x85EBCA77u;
+}
+
+/**
+ * Finds a cell in the cell table
+ * \param grid The spatial grid
+ * \param x The x coordinate of the cell
+ * \param y The y coordinate of the cell
+ * \return The position of the cell, or of the empty entry where it should be inserted
+ */
+static uint32_t _probe(_SSGE_SpatialGrid *grid, int32_t x, int32_t y) {
+    uint32_t mask = grid->cellSize - 1;
+    uint32_t pos = _hash(x, y) & mask;
+    while (grid->cells[pos].used && (grid->cells[pos].x != x || grid->cells[pos].y != y))
+        pos = (pos + 1) & mask;
+    return pos;
+}
+
+static void _growCells(_SSGE_SpatialGrid *grid) {
+    _SSGE_GridCell *old = grid->cells;
+    uint32_t oldSize = grid->cellSize;
+
+    grid->cellSize = oldSize * _GROWTH_FACTOR;
+    grid->cells = (_SSGE_GridCell *)calloc(grid->cellSize, sizeof(_SSGE_GridCell));
+    if (grid->cells == NULL)
+        SSGE_Error("Failed to allocate memory for spatial grid")
+
+    for (uint32_t i = 0; i < oldSize; i++)
+        if (old[i].used) grid->cells[_probe(grid, old[i].x, old[i].y)] = old[i];
+    free(old);
+}
+
+// Gets a cell, creating it if needed
+static _SSGE_GridCell *_getCell(_SSGE_SpatialGrid *grid, int32_t x, int32_t y) {
+    uint32_t pos = _probe(grid, x, y);
+    if (grid->cells[pos].used) return &grid->cells[pos];
+
+    // Keep the load factor under 3/4
+    if ((grid->cellCount + 1) * 4 > grid->cellSize * 3) {
+        _growCells(grid);
+        pos = _probe(grid, x, y);
+    }
+    grid->cells[pos] = (_SSGE_GridCell){.x = x, .y = y, .used = true};
+    ++grid->cellCount;
+    return &grid->cells[pos];
+}
+
+static void _cellAdd(_SSGE_GridCell *cell, _SSGE_GridNode *nodes, uint32_t node) {
+    if (cell->count == cell->size) {
+        uint32_t size = cell->size ? cell->size * _GROWTH_FACTOR : _CELL_INITIAL_SIZE;
+        uint32_t *array = (uint32_t *)realloc(cell->nodes, sizeof(uint32_t) * size);
+        if (array == NULL)
+            SSGE_Error("Failed to allocate memory for spatial grid")
+        cell->nodes = array;
+        cell->size = size;
+    }
+    nodes[node].index = cell->count;
+    cell->nodes[cell->count++] = node;
+}
+
+static void _cellRemove(_SSGE_GridCell *cell, _SSGE_GridNode *nodes, uint32_t node) {
+    uint32_t index = nodes[node].index;
+    uint32_t last = cell->nodes[--cell->count];
+    cell->nodes[index] = last;
+    nodes[last].index = index;
+}
+
+// Places a node in the cell matching a rect
+static void _place(_SSGE_SpatialGrid *grid, uint32_t node, const SDL_Rect *rect) {
+    _SSGE_GridNode *ptr = &grid->nodes[node];
+    ptr->large = rect->w > _CELL_SIZE || rect->h > _CELL_SIZE;
+    if (ptr->large) {
+        _cellAdd(&grid->large, grid->nodes, node);
+        return;
+    }
+    ptr->cellX = _cellOf(rect->x);
+    ptr->cellY = _cellOf(rect->y);
+    _cellAdd(_getCell(grid, ptr->cellX, ptr->cellY), grid->nodes, node);
+}
+
+/**
+ * Releases an empty cell of the cell table
+ * \param grid The spatial grid
+ * \param pos The position of the cell
+ * \note The following cells of the probe sequence are shifted back, so no tombstone is left behind
+ */
+static void _releaseCell(_SSGE_SpatialGrid *grid, uint32_t pos) {
+    uint32_t mask = grid->cellSize - 1;
+    free(grid->cells[pos].nodes);
+
+    for (uint32_t next = (pos + 1) & mask; grid->cells[next].used; next = (next + 1) & mask) {
+        // A cell can only move back if its home position is not between the hole and itself
+        uint32_t home = _hash(grid->cells[next].x, grid->cells[next].y) & mask;
+        if (pos <= next ? (pos < home && home <= next) : (pos < home || home <= next)) continue;
+        grid->cells[pos] = grid->cells[next];
+        pos = next;
+    }
+    grid->cells[pos] = (_SSGE_GridCell){0};
+    --grid->cellCount;
+}
+
+static void _unplace(_SSGE_SpatialGrid *grid, uint32_t node) {
+    _SSGE_GridNode *ptr = &grid->nodes[node];
+    if (ptr->large) {
+        _cellRemove(&grid->large, grid->nodes, node);
+        return;
+    }
+
+    // Cells are released once empty, so sprites travelling across the world don't grow the table
+    uint32_t pos = _probe(grid, ptr->cellX, ptr->cellY);
+    _cellRemove(&grid->cells[pos], grid->nodes, node);
+    if (grid->cells[pos].count == 0) _releaseCell(grid, pos);
+}
+
+/**
+ * Creates a spatial grid
+ * \param grid The spatial grid to initialize
+ */
+SSGEAPI void SSGE_Grid_Create(_SSGE_SpatialGrid *grid) {
+    grid->nodes = NULL;
+    grid->nodeCount = 0;
+    grid->nodeSize = 0;
+    grid->freeNode = UINT32_MAX;
+    grid->cells = (_SSGE_GridCell *)calloc(_CELLS_INITIAL_SIZE, sizeof(_SSGE_GridCell));
+    if (grid->cells == NULL)
+        SSGE_Error("Failed to allocate memory for spatial grid")
+    grid->cellCount = 0;
+    grid->cellSize = _CELLS_INITIAL_SIZE;
+    grid->large = (_SSGE_GridCell){0};
+}
+
+/**
+ * Inserts a persistent render data in a spatial grid
+ * \param grid The spatial grid
+ * \param texture The texture of the render data
+ * \param renderId The id of the render data in the texture render queue
+ * \param rect The dest rect of the render data
+ * \return The node of the render data
+ */
+SSGEAPI uint32_t SSGE_Grid_Insert(_SSGE_SpatialGrid *grid, SSGE_Texture *texture, uint32_t renderId, const SDL_Rect *rect) {
+    uint32_t node = grid->freeNode;
+    if (node != UINT32_MAX) {
+        grid->freeNode = grid->nodes[node].index;
+    } else {
+        if (grid->nodeCount == grid->nodeSize) {
+            uint32_t size = grid->nodeSize ? grid->nodeSize * _GROWTH_FACTOR : _NODES_INITIAL_SIZE;
+            _SSGE_GridNode *nodes = (_SSGE_GridNode *)realloc(grid->nodes, sizeof(_SSGE_GridNode) * size);
+            if (nodes == NULL)
+                SSGE_Error("Failed to allocate memory for spatial grid")
+            grid->nodes = nodes;
+            grid->nodeSize = size;
+        }
+        node = grid->nodeCount++;
+    }
+
+    grid->nodes[node].texture = texture;
+    grid->nodes[node].renderId = renderId;
+    _place(grid, node, rect);
+    return node;
+}
+
+/**
+ * Moves a node of a spatial grid after its render data moved or was resized
+ * \param grid The spatial grid
+ * \param node The node
+ * \param rect The new dest rect of the render data
+ */
+SSGEAPI void SSGE_Grid_Update(_SSGE_SpatialGrid *grid, uint32_t node, const SDL_Rect *rect) {
+    _SSGE_GridNode *ptr = &grid->nodes[node];
+    bool large = rect->w > _CELL_SIZE || rect->h > _CELL_SIZE;
+    if (large && ptr->large) return;
+    if (!large && !ptr->large && ptr->cellX == _cellOf(rect->x) && ptr->cellY == _cellOf(rect->y)) return;
+
+    _unplace(grid, node);
+    _place(grid, node, rect);
+}
+
+/**
+ * Removes a node from a spatial grid
+ * \param grid The spatial grid
+ * \param node The node
+ */
+SSGEAPI void SSGE_Grid_Remove(_SSGE_SpatialGrid *grid, uint32_t node) {
+    _unplace(grid, node);
+    grid->nodes[node].texture = NULL;
+    grid->nodes[node].index = grid->freeNode;
+    grid->freeNode = node;
+}
+
+/**
+ * Removes every node of a texture from a spatial grid
+ * \param grid The spatial grid
+ * \param texture The texture
+ */
+SSGEAPI void SSGE_Grid_RemoveTexture(_SSGE_SpatialGrid *grid, SSGE_Texture *texture) {
+    for (uint32_t i = 0; i < grid->nodeCount; i++)
+        if (grid->nodes[i].texture == texture)
+            SSGE_Grid_Remove(grid, i);
+}
+
+static inline void _visitCell(_SSGE_SpatialGrid *grid, _SSGE_GridCell *cell, _SSGE_GridVisit visit) {
+    for (uint32_t i = 0; i < cell->count; i++)
+        visit(&grid->nodes[cell->nodes[i]]);
+}
+
+/**
+ * Visits the nodes that may intersect a region
+ * \param grid The spatial grid
+ * \param view The region
+ * \param visit The function called for each node
+ */
+SSGEAPI void SSGE_Grid_Query(_SSGE_SpatialGrid *grid, const SDL_Rect *view, _SSGE_GridVisit visit) {
+    _visitCell(grid, &grid->large, visit);
+
+    // Nodes are placed by their top-left corner and are at most a cell large, so the cells before the region are visited too
+    int32_t x0 = _cellOf(view->x) - 1, y0 = _cellOf(view->y) - 1;
+    int32_t x1 = _cellOf(view->x + view->w), y1 = _cellOf(view->y + view->h);
+
+    // Zoomed out far enough, walking the table is cheaper than probing every cell of the region
+    if ((int64_t)(x1 - x0 + 1) * (y1 - y0 + 1) > (int64_t)grid->cellSize) {
+        for (uint32_t i = 0; i < grid->cellSize; i++) {
+            _SSGE_GridCell *cell = &grid->cells[i];
+            if (cell->used && cell->x >= x0 && cell->x <= x1 && cell->y >= y0 && cell->y <= y1)
+                _visitCell(grid, cell, visit);
+        }
+        return;
+    }
+
+    for (int32_t y = y0; y <= y1; y++) {
+        for (int32_t x = x0; x <= x1; x++) {
+            _SSGE_GridCell *cell = &grid->cells[_probe(grid, x, y)];
+            if (cell->used) _visitCell(grid, cell, visit);
+        }
+    }
+}
+
+/**
+ * Destroys a spatial grid
+ * \param grid The spatial grid to destroy
+ */
+SSGEAPI void SSGE_Grid_Destroy(_SSGE_SpatialGrid *grid) {
+    for (uint32_t i = 0; i < grid->cellSize; i++)
+        free(grid->cells[i].nodes);
+    free(grid->cells);
+    free(grid->large.nodes);
+    free(grid->nodes);
+    *grid = (_SSGE_SpatialGrid){0};
+}
@@ -0,0 +1,78 @@
+// Internal spatial grid functions
+
+#ifndef __SSGE_GRID_H__
+#define __SSGE_GRID_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern _SSGE_SpatialGrid _renderGrid;
+
+// Function called for each node found by `SSGE_Grid_Query`
+typedef void (*_SSGE_GridVisit)(_SSGE_GridNode *node);
+
+/**
+ * Create a spatial grid
+ * \param grid The spatial grid to initialize
+ */
+SSGEAPI void SSGE_Grid_Create(_SSGE_SpatialGrid *grid);
+
+/**
+ * Insert a persistent render data in a spatial grid
+ * \param grid The spatial grid
+ * \param texture The texture of the render data
+ * \param renderId The id of the render data in the texture render queue
+ * \param rect The dest rect of the render data
+ * \return The node of the render data
+ */
+SSGEAPI uint32_t SSGE_Grid_Insert(_SSGE_SpatialGrid *grid, SSGE_Texture *texture, uint32_t renderId, const SDL_Rect *rect);
+
+/**
+ * Move a node of a spatial grid after its render data moved or was resized
+ * \param grid The spatial grid
+ * \param node The node
+ * \param rect The new dest rect of the render data
+ */
+SSGEAPI void SSGE_Grid_Update(_SSGE_SpatialGrid *grid, uint32_t node, const SDL_Rect *rect);
+
+/**
+ * Remove a node from a spatial grid
+ * \param grid The spatial grid
+ * \param node The node
+ */
+SSGEAPI void SSGE_Grid_Remove(_SSGE_SpatialGrid *grid, uint32_t node);
+
+/**
+ * Remove every node of a texture from a spatial grid
+ * \param grid The spatial grid
+ * \param texture The texture
+ */
+SSGEAPI void SSGE_Grid_RemoveTexture(_SSGE_SpatialGrid *grid, SSGE_Texture *texture);
+
+/**
+ * Visit the nodes that may intersect a region
+ * \param grid The spatial grid
+ * \param view The region
+ * \param visit The function called for each node
+ * \note Nodes are found by cell, their dest rect must still be tested against the region
+ */
+SSGEAPI void SSGE_Grid_Query(_SSGE_SpatialGrid *grid, const SDL_Rect *view, _SSGE_GridVisit visit);
+
+/**
+ * Destroy a spatial grid
+ * \param grid The spatial grid to destroy
+ */
+SSGEAPI void SSGE_Grid_Destroy(_SSGE_SpatialGrid *grid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_GRID_H__
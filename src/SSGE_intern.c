@@ -0,0 +1,168 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "SSGE_local.h"
+#include "SSGE_error.h"
+
+#define _TABLE_INITIAL_SIZE 256
+#define _GROWTH_FACTOR 2
+
+#define _HEADER(interned) ((_SSGE_InternString *)((char *)(interned) - offsetof(_SSGE_InternString, string)))
+
+/**
+ * Hashes a string (FNV-1a)
+ * \param string The string to hash
+ * \return The hash of the string
+ */
+SSGEAPI uint32_t SSGE_Intern_HashString(const char *string) {
+    uint32_t hash = 2166136261u;
+    while (*string) {
+        hash ^= (uint8_t)*string++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Finds the entry of a string in the intern table
+ * \param string The string to find
+ * \param hash The hash of the string
+ * \return The position of the entry of the string, or of the empty entry where it should be inserted
+ */
+static uint32_t _probe(const char *string, uint32_t hash) {
+    uint32_t mask = _internTable.size - 1;
+    uint32_t pos = hash & mask;
+    while (_internTable.entries[pos] != NULL) {
+        if (_internTable.entries[pos]->hash == hash && strcmp(_internTable.entries[pos]->string, string) == 0)
+            break;
+        pos = (pos + 1) & mask;
+    }
+    return pos;
+}
+
+/**
+ * Grows the intern table
+ * \param size The new size of the table
+ */
+static void _grow(uint32_t size) {
+    _SSGE_InternString **old = _internTable.entries;
+    uint32_t oldSize = _internTable.size;
+
+    _internTable.entries = (_SSGE_InternString **)calloc(size, sizeof(_SSGE_InternString *));
+    if (_internTable.entries == NULL)
+        SSGE_Error("Failed to allocate memory for intern table")
+    _internTable.size = size;
+
+    uint32_t mask = size - 1;
+    for (uint32_t i = 0; i < oldSize; i++) {
+        if (old[i] == NULL) continue;
+        uint32_t pos = old[i]->hash & mask;
+        while (_internTable.entries[pos] != NULL)
+            pos = (pos + 1) & mask;
+        _internTable.entries[pos] = old[i];
+    }
+    free(old);
+}
+
+/**
+ * Frees an interned string
+ * \param header The interned string
+ */
+static void _free(_SSGE_InternString *header) {
+    size_t size = sizeof(_SSGE_InternString) + strlen(header->string) + 1;
+    if (size <= _NAME_BLOCK_SIZE)
+        SSGE_Pool_Free(&_namePool, header);
+    else
+        free(header);
+    _internTable.bytes -= size;
+}
+
+/**
+ * Gets the interned copy of a string, interning it if needed
+ * \param string The string
+ * \return The interned string
+ */
+SSGEAPI const char *SSGE_Intern_Acquire(const char *string) {
+    if ((_internTable.count + 1) * 4 > _internTable.size * 3)
+        _grow(_internTable.size ? _internTable.size * _GROWTH_FACTOR : _TABLE_INITIAL_SIZE);
+
+    uint32_t hash = SSGE_Intern_HashString(string);
+    uint32_t pos = _probe(string, hash);
+    if (_internTable.entries[pos] != NULL) {
+        _internTable.entries[pos]->refs++;
+        return _internTable.entries[pos]->string;
+    }
+
+    size_t length = strlen(string);
+    size_t size = sizeof(_SSGE_InternString) + length + 1;
+    _SSGE_InternString *header = size <= _NAME_BLOCK_SIZE ? SSGE_Pool_Alloc(&_namePool) : malloc(size);
+    if (header == NULL)
+        SSGE_Error("Failed to allocate memory for name")
+    header->hash = hash;
+    header->refs = 1;
+    memcpy(header->string, string, length + 1);
+
+    _internTable.entries[pos] = header;
+    _internTable.count++;
+    _internTable.bytes += size;
+    return header->string;
+}
+
+/**
+ * Finds the interned copy of a string
+ * \param string The string
+ * \return The interned string, or NULL if the string is not interned
+ */
+SSGEAPI const char *SSGE_Intern_Find(const char *string) {
+    if (_internTable.count == 0) return NULL;
+
+    _SSGE_InternString *header = _internTable.entries[_probe(string, SSGE_Intern_HashString(string))];
+    return header ? header->string : NULL;
+}
+
+/**
+ * Gets the hash of an interned string
+ * \param interned The interned string
+ * \return The hash of the string
+ */
+SSGEAPI uint32_t SSGE_Intern_Hash(const char *interned) {
+    return _HEADER(interned)->hash;
+}
+
+/**
+ * Releases an interned string, freeing it when it is no longer referenced
+ * \param interned The interned string
+ */
+SSGEAPI void SSGE_Intern_Release(const char *interned) {
+    _SSGE_InternString *header = _HEADER(interned);
+    if (--header->refs > 0) return;
+
+    // Remove the entry, shifting back the entries that follow it
+    uint32_t mask = _internTable.size - 1;
+    uint32_t pos = header->hash & mask;
+    while (_internTable.entries[pos] != header)
+        pos = (pos + 1) & mask;
+    for (uint32_t next = (pos + 1) & mask; _internTable.entries[next] != NULL; next = (next + 1) & mask) {
+        uint32_t home = _internTable.entries[next]->hash & mask;
+        if (((next - home) & mask) >= ((next - pos) & mask)) {
+            _internTable.entries[pos] = _internTable.entries[next];
+            pos = next;
+        }
+    }
+    _internTable.entries[pos] = NULL;
+    _internTable.count--;
+
+    _free(header);
+}
+
+/**
+ * Destroys the intern table and every string left in it
+ */
+SSGEAPI void SSGE_Intern_Destroy() {
+    for (uint32_t i = 0; i < _internTable.size; i++)
+        if (_internTable.entries[i] != NULL)
+            _free(_internTable.entries[i]);
+    free(_internTable.entries);
+    _internTable = (_SSGE_InternTable){0};
+}
@@ -0,0 +1,61 @@
+// Internal string interning functions
+
+#ifndef __SSGE_INTERN_H__
+#define __SSGE_INTERN_H__
+
+#include <stdint.h>
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern _SSGE_InternTable _internTable;
+
+/**
+ * Hash a string (FNV-1a)
+ * \param string The string to hash
+ * \return The hash of the string
+ */
+SSGEAPI uint32_t SSGE_Intern_HashString(const char *string);
+
+/**
+ * Get the interned copy of a string, interning it if needed
+ * \param string The string
+ * \return The interned string
+ * \note Every call must be matched by a call to `SSGE_Intern_Release`
+ */
+SSGEAPI const char *SSGE_Intern_Acquire(const char *string);
+
+/**
+ * Find the interned copy of a string
+ * \param string The string
+ * \return The interned string, or NULL if the string is not interned
+ */
+SSGEAPI const char *SSGE_Intern_Find(const char *string);
+
+/**
+ * Get the hash of an interned string
+ * \param interned The interned string
+ * \return The hash of the string
+ */
+SSGEAPI uint32_t SSGE_Intern_Hash(const char *interned);
+
+/**
+ * Release an interned string, freeing it when it is no longer referenced
+ * \param interned The interned string
+ */
+SSGEAPI void SSGE_Intern_Release(const char *interned);
+
+/**
+ * Destroy the intern table and every string left in it
+ */
+SSGEAPI void SSGE_Intern_Destroy();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_INTERN_H__
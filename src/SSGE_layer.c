@@ -0,0 +1,139 @@
+#include "SSGE_local.h"
+#include "SSGE/SSGE_layer.h"
+
+SSGEAPI void SSGE_Layer_SetStatic(int16_t layer, bool isStatic) {
+    _SSGE_StaticLayer *ptr = staticLayer(layer);
+    if (isStatic) {
+        if (ptr != NULL) return;
+        if (_staticLayers.count == _SSGE_STATIC_LAYERS_MAX)
+            SSGE_Error("Too many static layers")
+        _staticLayers.layers[_staticLayers.count++] = (_SSGE_StaticLayer){.layer = layer, .dirty = true};
+        return;
+    }
+
+    if (ptr == NULL) return;
+    if (ptr->cache) SDL_DestroyTexture(ptr->cache);
+    *ptr = _staticLayers.layers[--_staticLayers.count];
+}
+
+SSGEAPI void SSGE_Layer_Invalidate(int16_t layer) {
+    invalidateLayer(layer);
+}
+
+/**
+ * Gets a static layer
+ * \param layer The layer number
+ * \return The static layer, NULL if the layer is not static
+ */
+_SSGE_StaticLayer *staticLayer(int16_t layer) {
+    for (uint32_t i = 0; i < _staticLayers.count; i++)
+        if (_staticLayers.layers[i].layer == layer)
+            return &_staticLayers.layers[i];
+    return NULL;
+}
+
+/**
+ * Marks a layer to be redrawn, if it is static
+ * \param layer The layer number
+ */
+void invalidateLayer(int16_t layer) {
+    _SSGE_StaticLayer *ptr = staticLayer(layer);
+    if (ptr != NULL) ptr->dirty = true;
+}
+
+/**
+ * Marks every static layer to be redrawn
+ */
+void invalidateLayers() {
+    for (uint32_t i = 0; i < _staticLayers.count; i++)
+        _staticLayers.layers[i].dirty = true;
+}
+
+/**
+ * Prepares the static layers for a frame, before their render data are pushed
+ * \param size The maximum number of render commands of a layer
+ * \note The caches are resized to the camera viewport, which redraws them
+ */
+void beginStaticLayers(uint32_t size) {
+    if (_staticLayers.count == 0) return;
+
+    SDL_Rect rect;
+    cameraView(&rect);
+    cameraApply(&rect);
+
+    for (uint32_t i = 0; i < _staticLayers.count; i++) {
+        _SSGE_StaticLayer *ptr = &_staticLayers.layers[i];
+        if (ptr->cache == NULL || ptr->width != rect.w || ptr->height != rect.h) {
+            if (ptr->cache) SDL_DestroyTexture(ptr->cache);
+            ptr->cache = SDL_CreateTexture(_engine.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, rect.w, rect.h);
+            if (ptr->cache == NULL)
+                SSGE_ErrorEx("Failed to create static layer cache: %s", SDL_GetError())
+
+            // The cache holds premultiplied colors once the sprites are blended into it
+            SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+            if (SDL_SetTextureBlendMode(ptr->cache, premultiplied) != 0)
+                SDL_SetTextureBlendMode(ptr->cache, SDL_BLENDMODE_BLEND);
+            ptr->width = rect.w;
+            ptr->height = rect.h;
+            ptr->dirty = true;
+        }
+
+        if (ptr->dirty) SSGE_CommandQueue_Begin(&ptr->commands, size);
+        else ptr->commands = (_SSGE_CommandQueue){0};
+    }
+}
+
+/**
+ * Redraws the invalidated static layers, then pushes their caches to the render commands
+ * \param view The region of the world seen by the camera
+ * \param sortKey The texture part of the sort key of the last texture, incremented for each cache
+ */
+void renderStaticLayers(const SDL_Rect *view, uint32_t *sortKey) {
+    if (_staticLayers.count == 0) return;
+
+    SDL_Rect viewport;
+    float scale, offsetX, offsetY;
+    cameraViewport(&viewport);
+    cameraTransform(&scale, &offsetX, &offsetY);
+
+    SDL_Texture *target = SDL_GetRenderTarget(_engine.renderer);
+    bool redrawn = false;
+    for (uint32_t i = 0; i < _staticLayers.count; i++) {
+        _SSGE_StaticLayer *ptr = &_staticLayers.layers[i];
+        if (ptr->dirty) {
+            SDL_SetRenderTarget(_engine.renderer, ptr->cache);
+            SDL_SetRenderDrawColor(_engine.renderer, 0, 0, 0, 0);
+            SDL_RenderClear(_engine.renderer);
+
+            // The cache covers the viewport, its top-left corner is the one of the viewport
+            SSGE_CommandQueue_Sort(&ptr->commands);
+            SSGE_SpriteBatch_SetTransform(&_spriteBatch, scale, offsetX - (float)viewport.x, offsetY - (float)viewport.y);
+            SSGE_CommandQueue_Submit(&ptr->commands, &_spriteBatch, view);
+            ptr->dirty = false;
+            redrawn = true;
+        }
+
+        _SSGE_RenderData *data = (_SSGE_RenderData *)SSGE_Arena_Alloc(&_frameArena, sizeof(_SSGE_RenderData));
+        *data = (_SSGE_RenderData){
+            .dest = *view,
+            .layer = ptr->layer
+        };
+        SSGE_CommandQueue_Push(&_renderCommands, ptr->cache, ++*sortKey, NULL, data);
+    }
+
+    if (redrawn) {
+        SDL_SetRenderTarget(_engine.renderer, target);
+        SDL_SetRenderDrawColor(_engine.renderer, _color.r, _color.g, _color.b, _color.a);
+    }
+}
+
+/**
+ * Destroys the caches of the static layers
+ */
+void destroyStaticLayers() {
+    for (uint32_t i = 0; i < _staticLayers.count; i++)
+        if (_staticLayers.layers[i].cache) SDL_DestroyTexture(_staticLayers.layers[i].cache);
+    _staticLayers.count = 0;
+}
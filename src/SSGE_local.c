@@ -9,53 +9,113 @@ SSGE_Array  _audioList          = {0};
 SSGE_Array  _animationList      = {0};
 SSGE_Array  _playingAnim        = {0};
 SSGE_Event  _event              = {0};
+_SSGE_Arena _frameArena         = {0};
+_SSGE_SpriteBatch _spriteBatch  = {0};
+_SSGE_CommandQueue _renderCommands = {0};
+_SSGE_DamageList _damage        = {0};
+_SSGE_SpatialGrid _renderGrid   = {0};
+_SSGE_Pool  _objectPool         = {0};
+_SSGE_Pool  _animStatePool      = {0};
+_SSGE_Pool  _namePool           = {0};
+_SSGE_ObjectTransforms _objectTransforms = {0};
+_SSGE_InternTable _internTable  = {0};
 SSGE_Color  _color              = {0, 0, 0, 255};
 SSGE_Color  _bgColor            = {0, 0, 0, 255};
+int16_t     _drawLayer          = 0;
+uint16_t    _drawDepth          = 0;
+_SSGE_Camera _camera            = {0, 0, 1.0f, {0, 0, 0, 0}};
+_SSGE_StaticLayers _staticLayers = {0};
+_SSGE_Profiler _profiler        = {0};
+_SSGE_Trace _trace              = {0};
 bool        _manualUpdateFrame  = false;
 bool        _updateFrame        = true; // set to true to draw the first frame
 
+void releaseName(char *name) {
+    if (name) SSGE_Intern_Release(name);
+}
+
 void destroyTexture(SSGE_Texture *ptr) {
-    SDL_DestroyTexture(ptr->texture);
-    SSGE_Array_Destroy(&ptr->queue, free);
-    if (ptr->name) free(ptr->name);
+    if (ptr->queue.persistentCount != 0) {
+        SSGE_Grid_RemoveTexture(&_renderGrid, ptr);
+        invalidateLayers();
+        if (_engine.partialRedraw) SSGE_Damage_AddAll(&_damage);
+    }
+    if (ptr->atlas) removeFromAtlas(ptr);
+    else SDL_DestroyTexture(ptr->texture);
+    SSGE_RenderQueue_Destroy(&ptr->queue);
+    releaseName(ptr->name);
     free(ptr);
 }
 
 void destroyObject(SSGE_Object *ptr) {
-    if (ptr->name) free(ptr->name);
+    releaseName(ptr->name);
     if (ptr->destroyData != NULL)
         ptr->destroyData(ptr->data);
-    if (ptr->spriteType == SSGE_SPRITE_STATIC)
-        free(SSGE_Array_Pop(&ptr->texture.texture->queue, ptr->texture.renderDataIdx));
-    free(ptr);
+    if (ptr->spriteType == SSGE_SPRITE_STATIC && ptr->texture.gridNode != UINT32_MAX) { // Not hidden
+        _SSGE_RenderData *data = SSGE_RenderQueue_Get(&ptr->texture.texture->queue, ptr->texture.renderDataIdx);
+        if (data != NULL) markRenderDamage(data);
+        SSGE_RenderQueue_Remove(&ptr->texture.texture->queue, ptr->texture.renderDataIdx);
+        SSGE_Grid_Remove(&_renderGrid, ptr->texture.gridNode);
+    } else if (ptr->spriteType == SSGE_SPRITE_ANIM) {
+        SSGE_AnimationState *state = SSGE_Array_Pop(&_playingAnim, ptr->animation);
+        if (state != NULL) {
+            markAnimationDamage(state);
+            destroyAnimationState(state);
+        }
+    } else if (ptr->spriteType == SSGE_SPRITE_SHARED && ptr->shared.instance != UINT32_MAX) {
+        removeAnimationInstance(ptr->shared.clock, ptr->shared.instance);
+    }
+    SSGE_Pool_Free(&_objectPool, ptr);
+}
+
+SSGE_Object *popObject(uint32_t id) {
+    uint32_t pos = SSGE_SlotTable_Resolve(_objectList.slots, _objectList.count, id);
+    if (pos == UINT32_MAX) return NULL;
+
+    // The last object is moved to the freed position, move its transform too
+    SSGE_Object *object = SSGE_Array_Pop(&_objectList, id);
+    SSGE_Transforms_Copy(&_objectTransforms, _objectList.count, pos);
+    return object;
 }
 
 void destroyTemplate(SSGE_ObjectTemplate *ptr) {
-    if (ptr->name) free(ptr->name);
+    releaseName(ptr->name);
     free(ptr);
 }
 
 void destroyFont(SSGE_Font *ptr) {
     TTF_CloseFont(ptr->font);
-    if (ptr->name) free(ptr->name);
+    releaseName(ptr->name);
     free(ptr);
 }
 
 void destroyAudio(SSGE_Audio *ptr) {
     Mix_FreeChunk(ptr->audio);
-    if (ptr->name) free(ptr->name);
+    releaseName(ptr->name);
     free(ptr);
 }
 
 void destroyAnimation(SSGE_Animation *ptr) {
     if (ptr->type == SSGE_ANIM_FRAMES) {
         for (uint32_t i = 0; i < ptr->data.frameCount; i++) {
-            if (ptr->data.frames[i] != NULL) {
+            // The sprite sheet belongs to its tilemap
+            if (ptr->data.frames[i] != NULL && ptr->data.frames[i] != ptr->data.sheet) {
                 SDL_DestroyTexture(ptr->data.frames[i]);
             }
         }
         free(ptr->data.frames);
+        free(ptr->data.frametimes);
+        free(ptr->data.srcRects);
     }
-    if (ptr->name) free(ptr->name);
+    releaseName(ptr->name);
     free(ptr);
 }
+
+void destroyAnimationState(SSGE_AnimationState *ptr) {
+    if (ptr->clock != NULL) {
+        free(ptr->clock->instances);
+        SSGE_SlotTable_Destroy(&ptr->clock->slots);
+        free(ptr->clock);
+    }
+    SSGE_Pool_Free(&_animStatePool, ptr);
+}
@@ -8,23 +8,32 @@
 #include <SDL2/SDL_mixer.h>
 #include "SSGE_typedef.h"
 #include "SSGE_array.h"
+#include "SSGE_render.h"
+#include "SSGE_batch.h"
+#include "SSGE_damage.h"
+#include "SSGE_grid.h"
+#include "SSGE_arena.h"
+#include "SSGE_pool.h"
+#include "SSGE_transform.h"
+#include "SSGE_intern.h"
 #include "SSGE_error.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#define _LIST_INITIAL_SIZE          256
 #define _PLAYING_ANIM_INITIAL_SIZE  64
 #define _PLAYING_ANIM_GROWTH_FACTOR 2
 #define _MAX_FRAMESKIP              3
+#define _SPIN_TIME                  2   // Milliseconds spun before a deadline instead of sleeping
+#define _HIDDEN_FRAME_TIME          100 // Milliseconds between the frames while the window is hidden
+#define _POOL_SLAB_BLOCKS           256
+#define _NAME_BLOCK_SIZE            32  // Longer interned names are allocated separately
+#define _TRANSFORMS_INITIAL_SIZE    256
 
-typedef struct {
-    SDL_Rect    dest;
-    SSGE_Flip   flip;
-    SSGE_Point  rotationCenter;
-    double      angle;
-    bool        once;
-} _SSGE_RenderData;
+// Source rect of a texture for SDL_RenderCopy
+#define _TEXTURE_SRC(texture) ((texture)->src.w ? &(texture)->src : NULL)
 
 // Dummy type
 typedef struct _DummyType {
@@ -42,18 +51,44 @@ extern SSGE_Array   _animationList;
 extern SSGE_Array   _playingAnim;
 extern SSGE_Color   _color;
 extern SSGE_Color   _bgColor;
+extern int16_t      _drawLayer;
+extern uint16_t     _drawDepth;
+extern _SSGE_Camera _camera;
+extern _SSGE_StaticLayers _staticLayers;
+extern _SSGE_Profiler _profiler;
+extern _SSGE_Trace  _trace;
 extern bool         _manualUpdateFrame;
 extern bool         _updateFrame;
 
+void releaseName(char *name);
+void markDamage(int x, int y, int width, int height);
+void markRenderDamage(const _SSGE_RenderData *data);
+void markDrawDamage(const _SSGE_RenderData *data);
+void markAnimationDamage(const SSGE_AnimationState *state);
+void markInstanceDamage(const SSGE_AnimationState *state, const _SSGE_AnimationInstance *instance);
+uint32_t addAnimationInstance(uint32_t id, int x, int y, uint32_t phase);
+bool moveAnimationInstance(uint32_t id, uint32_t instance, int x, int y);
+bool removeAnimationInstance(uint32_t id, uint32_t instance);
+void cameraViewport(SDL_Rect *viewport);
+void cameraView(SDL_Rect *view);
+void cameraTransform(float *scale, float *offsetX, float *offsetY);
+bool cameraApply(SDL_Rect *rect);
+void cameraUnapply(SDL_Rect *rect);
+_SSGE_StaticLayer *staticLayer(int16_t layer);
+void invalidateLayer(int16_t layer);
+void invalidateLayers();
+void beginStaticLayers(uint32_t size);
+void renderStaticLayers(const SDL_Rect *view, uint32_t *sortKey);
+void destroyStaticLayers();
+void profileBegin();
+void profileMark(SSGE_ProfilePhase phase);
+void profileSkip();
+void profileEnd();
+void profileOverlay();
+void traceZone(const char *name, uint64_t begin, uint64_t end);
+
 inline void _addToList(SSGE_Array *list, void *element, const char *name, uint32_t *id, const char *funcname) {
-    if (name) {
-        ((DummyType *)element)->name = (char *)malloc(sizeof(char) * (strlen(name) + 1));
-        if (((DummyType *)element)->name == NULL) {
-            fprintf(stderr, "[SSGE][%s] Failed to allocate memory for name\n", funcname);
-            exit(1);
-        }
-        strcpy(((DummyType *)element)->name, name);
-    } else ((DummyType *)element)->name = NULL;
+    ((DummyType *)element)->name = name ? (char *)SSGE_Intern_Acquire(name) : NULL;
 
     if (id == NULL) {
         fprintf(stderr, "[SSGE][%s] ID is discarded\n", funcname);
@@ -64,18 +99,24 @@ inline void _addToList(SSGE_Array *list, void *element, const char *name, uint32
 }
 
 inline void _initTextureFields(SSGE_Texture *texture) {
+    texture->src = (SDL_Rect){0, 0, 0, 0};
+    texture->atlas = NULL;
     texture->anchorX = 0;
     texture->anchorY = 0;
 
-    SSGE_Array_Create(&texture->queue);
+    SSGE_RenderQueue_Create(&texture->queue);
 }
 
 void destroyTexture(SSGE_Texture *ptr);
+void removeFromAtlas(SSGE_Texture *texture);
 void destroyObject(SSGE_Object *ptr);
 void destroyTemplate(SSGE_ObjectTemplate *ptr);
 void destroyFont(SSGE_Font *ptr);
 void destroyAudio(SSGE_Audio *ptr);
 void destroyAnimation(SSGE_Animation *ptr);
+void destroyAnimationState(SSGE_AnimationState *ptr);
+SSGE_Object *popObject(uint32_t id);
+void flushTextCache(bool all);
 
 #ifdef __cplusplus
 }
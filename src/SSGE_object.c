@@ -1,27 +1,91 @@
 #include "SSGE_local.h"
 #include "SSGE/SSGE_object.h"
 #include "SSGE/SSGE_animation.h"
+#include "SSGE/SSGE_camera.h"
+
+#define _X(pos)         _objectTransforms.x[pos]
+#define _Y(pos)         _objectTransforms.y[pos]
+#define _WIDTH(pos)     _objectTransforms.width[pos]
+#define _HEIGHT(pos)    _objectTransforms.height[pos]
+#define _HIDDEN(pos)    _objectTransforms.hidden[pos]
+#define _HITBOX(pos)    _objectTransforms.hitbox[pos]
+
+// Position of an object in the object list, and of its transform
+static inline uint32_t _pos(SSGE_Object *object) {
+    return SSGE_SlotTable_Resolve(_objectList.slots, _objectList.count, object->id);
+}
 
-SSGEAPI SSGE_Object *SSGE_Object_Create(uint32_t *id, const char *name, int x, int y, int width, int height, bool hitbox) {
-    SSGE_Object *object = (SSGE_Object *)malloc(sizeof(SSGE_Object));
-    if (object == NULL) 
-        SSGE_Error("Failed to allocate memory for object")
+// Render data of the static sprite of an object, NULL if it is hidden
+static inline _SSGE_RenderData *_spriteData(SSGE_Object *object) {
+    // A stale index may resolve to the render data of another object, it is never looked up
+    if (object->texture.gridNode == UINT32_MAX) return NULL;
+    return SSGE_RenderQueue_Get(&object->texture.texture->queue, object->texture.renderDataIdx);
+}
+
+// Marks the region of the static sprite of an object to be redrawn
+static inline void _damageSprite(SSGE_Object *object) {
+    if (object->spriteType != SSGE_SPRITE_STATIC || (!_engine.partialRedraw && _staticLayers.count == 0)) return;
+    _SSGE_RenderData *renderData = _spriteData(object);
+    if (renderData != NULL) markRenderDamage(renderData);
+}
+
+// Adds the static sprite of an object to the render queue of its texture and to the spatial grid
+static void _addSprite(SSGE_Object *object, uint32_t pos) {
+    SSGE_Texture *texture = object->texture.texture;
+    _SSGE_RenderData data = {
+        .dest = {
+            .x = _X(pos),
+            .y = _Y(pos),
+            .w = _WIDTH(pos),
+            .h = _HEIGHT(pos)
+        },
+        .layer = object->layer,
+        .depth = object->depth
+    };
+    object->texture.renderDataIdx = SSGE_RenderQueue_Add(&texture->queue, &data);
+    object->texture.gridNode = SSGE_Grid_Insert(&_renderGrid, texture, object->texture.renderDataIdx, &data.dest);
+}
+
+// Removes the static sprite of an object from the render queue of its texture and from the spatial grid
+static void _removeSprite(SSGE_Object *object) {
+    if (object->texture.gridNode == UINT32_MAX) return; // Hidden
+    SSGE_RenderQueue_Remove(&object->texture.texture->queue, object->texture.renderDataIdx);
+    SSGE_Grid_Remove(&_renderGrid, object->texture.gridNode);
+    object->texture.renderDataIdx = UINT32_MAX;
+    object->texture.gridNode = UINT32_MAX;
+}
+
+// Removes the instance of the shared animation of an object
+static void _removeInstance(SSGE_Object *object) {
+    if (object->shared.instance == UINT32_MAX) return; // Hidden, or the shared animation has ended
+    removeAnimationInstance(object->shared.clock, object->shared.instance);
+    object->shared.instance = UINT32_MAX;
+}
+
+// The object must be added to `_objectList` right after, its transform is set at the next position
+static SSGE_Object *_newObject(int x, int y, int width, int height, bool hitbox) {
+    SSGE_Object *object = (SSGE_Object *)SSGE_Pool_Alloc(&_objectPool);
 
     *object = (SSGE_Object) {
         .spriteType = SSGE_SPRITE_NONE,
         .texture = {
             .texture = NULL,
-            .renderDataIdx = 0,
+            .renderDataIdx = UINT32_MAX,
+            .gridNode = UINT32_MAX,
         },
-        .x = x,
-        .y = y,
-        .width = width,
-        .height = height,
-        .hitbox = hitbox,
         .data = NULL,
         .destroyData = NULL,
+        .layer = _drawLayer,
+        .depth = _drawDepth,
     };
 
+    SSGE_Transforms_Reserve(&_objectTransforms, _objectList.count + 1);
+    SSGE_Transforms_Set(&_objectTransforms, _objectList.count, x, y, width, height, hitbox);
+    return object;
+}
+
+SSGEAPI SSGE_Object *SSGE_Object_Create(uint32_t *id, const char *name, int x, int y, int width, int height, bool hitbox) {
+    SSGE_Object *object = _newObject(x, y, width, height, hitbox);
     _addToList(&_objectList, object, name, id, __func__);
     return object;
 }
@@ -35,31 +99,68 @@ SSGEAPI SSGE_Object *SSGE_Object_Instantiate(uint32_t *id, SSGE_ObjectTemplate *
     return object;
 }
 
+SSGEAPI void SSGE_Object_InstantiateBatch(SSGE_ObjectTemplate *template, uint32_t count, const SSGE_Point *positions, uint32_t *ids) {
+    if (ids == NULL)
+        SSGE_Warning("IDs are discarded")
+
+    // Grow every container once for the whole batch
+    SSGE_Array_Reserve(&_objectList, count);
+    SSGE_Transforms_Reserve(&_objectTransforms, _objectList.count + count);
+    if (template->spriteType == SSGE_SPRITE_STATIC)
+        SSGE_RenderQueue_Reserve(&template->texture->queue, count);
+    else if (template->spriteType == SSGE_SPRITE_ANIM)
+        SSGE_Array_Reserve(&_playingAnim, count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        int x = positions[i].x, y = positions[i].y;
+        SSGE_Object *object = _newObject(x, y, template->width, template->height, template->hitbox);
+        object->name = NULL;
+        object->id = SSGE_Array_Add(&_objectList, object);
+        if (ids) ids[i] = object->id;
+
+        if (template->spriteType == SSGE_SPRITE_STATIC) {
+            object->spriteType = SSGE_SPRITE_STATIC;
+            object->texture.texture = template->texture;
+            _addSprite(object, _pos(object));
+            _damageSprite(object);
+        } else if (template->spriteType == SSGE_SPRITE_ANIM) {
+            object->spriteType = SSGE_SPRITE_ANIM;
+            object->animation = SSGE_Animation_Play(template->animation, x, y, -1, false, false);
+        }
+    }
+}
+
 SSGEAPI bool SSGE_Object_Exists(uint32_t id) {
     SSGE_Object *ptr = SSGE_Array_Get(&_objectList, id);
     return ptr != NULL;
 }
 
-inline static bool _find_object_name(void *ptr, void *name) {
-    return strcmp(((SSGE_Object *)ptr)->name, (char *)name) == 0 ;
-}
-
 SSGEAPI bool SSGE_Object_ExistsName(const char *name) {
-    SSGE_Object *ptr = SSGE_Array_Find(&_objectList, _find_object_name, (void *)name);
+    SSGE_Object *ptr = SSGE_Array_GetName(&_objectList, name);
     return ptr != NULL;
 }
 
 SSGEAPI void SSGE_Object_Move(SSGE_Object *object, int x, int y) {
-    object->x = x;
-    object->y = y;
+    uint32_t pos = _pos(object);
+    _X(pos) = x;
+    _Y(pos) = y;
     switch (object->spriteType) {
         case SSGE_SPRITE_ANIM:
             SSGE_Animation_Move(object->animation, x, y);
             break;
+        case SSGE_SPRITE_SHARED:
+            // The shared animation may have ended, the sprite is then no longer drawn
+            if (object->shared.instance != UINT32_MAX && !moveAnimationInstance(object->shared.clock, object->shared.instance, x, y))
+                object->shared.instance = UINT32_MAX;
+            break;
         case SSGE_SPRITE_STATIC:
-            _SSGE_RenderData *renderData = SSGE_Array_Get(&object->texture.texture->queue, object->texture.renderDataIdx);
+            _SSGE_RenderData *renderData = _spriteData(object);
+            if (renderData == NULL) break; // Hidden
+            markRenderDamage(renderData);
             renderData->dest.x = x;
             renderData->dest.y = y;
+            SSGE_Grid_Update(&_renderGrid, object->texture.gridNode, &renderData->dest);
+            markRenderDamage(renderData);
             break;
         default:
             break;
@@ -67,16 +168,26 @@ SSGEAPI void SSGE_Object_Move(SSGE_Object *object, int x, int y) {
 }
 
 SSGEAPI void SSGE_Object_MoveRel(SSGE_Object *object, int dx, int dy) {
-    object->x += dx;
-    object->y += dy;
+    uint32_t pos = _pos(object);
+    int x = (_X(pos) += dx);
+    int y = (_Y(pos) += dy);
     switch (object->spriteType) {
         case SSGE_SPRITE_ANIM:
-            SSGE_Animation_Move(object->animation, object->x, object->y);
+            SSGE_Animation_Move(object->animation, x, y);
+            break;
+        case SSGE_SPRITE_SHARED:
+            // The shared animation may have ended, the sprite is then no longer drawn
+            if (object->shared.instance != UINT32_MAX && !moveAnimationInstance(object->shared.clock, object->shared.instance, x, y))
+                object->shared.instance = UINT32_MAX;
             break;
         case SSGE_SPRITE_STATIC:
-            _SSGE_RenderData *renderData = SSGE_Array_Get(&object->texture.texture->queue, object->texture.renderDataIdx);
-            renderData->dest.x = object->x;
-            renderData->dest.y = object->y;
+            _SSGE_RenderData *renderData = _spriteData(object);
+            if (renderData == NULL) break; // Hidden
+            markRenderDamage(renderData);
+            renderData->dest.x = x;
+            renderData->dest.y = y;
+            SSGE_Grid_Update(&_renderGrid, object->texture.gridNode, &renderData->dest);
+            markRenderDamage(renderData);
             break;
         default:
             break;
@@ -98,69 +209,104 @@ SSGEAPI void SSGE_Object_RemoveData(SSGE_Object *object) {
 }
 
 SSGEAPI void SSGE_Object_BindTexture(SSGE_Object *object, SSGE_Texture *texture) {
+    _damageSprite(object);
     if (object->spriteType == SSGE_SPRITE_STATIC)
-        free(SSGE_Array_Pop(&object->texture.texture->queue, object->texture.renderDataIdx));
+        _removeSprite(object);
+    else if (object->spriteType == SSGE_SPRITE_SHARED)
+        _removeInstance(object);
     object->spriteType = SSGE_SPRITE_STATIC;
-    _SSGE_RenderData *renderData = (_SSGE_RenderData *)malloc(sizeof(_SSGE_RenderData));
-    *renderData = (_SSGE_RenderData){
-        .dest = {
-            .x = object->x,
-            .y = object->y,
-            .w = object->width,
-            .h = object->height
-        },
-        .once = false
-    };
-    object->texture.renderDataIdx = SSGE_Array_Add(&texture->queue, renderData);
     object->texture.texture = texture;
+    _addSprite(object, _pos(object));
+    _damageSprite(object);
 }
 
 SSGEAPI void SSGE_Object_BindAnimation(SSGE_Object *object, SSGE_Animation *animation, bool reversed, bool pingpong) {
+    _damageSprite(object);
     if (object->spriteType == SSGE_SPRITE_STATIC)
-        free(SSGE_Array_Pop(&object->texture.texture->queue, object->texture.renderDataIdx));
+        _removeSprite(object);
+    else if (object->spriteType == SSGE_SPRITE_SHARED)
+        _removeInstance(object);
+    uint32_t pos = _pos(object);
     object->spriteType = SSGE_SPRITE_ANIM;
-    object->animation = SSGE_Animation_Play(animation, object->x, object->y, -1, reversed, pingpong);
+    object->animation = SSGE_Animation_Play(animation, _X(pos), _Y(pos), -1, reversed, pingpong);
+    SSGE_Animation_SetLayer(object->animation, object->layer, object->depth);
+}
+
+SSGEAPI void SSGE_Object_BindSharedAnimation(SSGE_Object *object, uint32_t id, uint32_t phase) {
+    _damageSprite(object);
+    if (object->spriteType == SSGE_SPRITE_STATIC)
+        _removeSprite(object);
+    else if (object->spriteType == SSGE_SPRITE_SHARED)
+        _removeInstance(object);
+    uint32_t pos = _pos(object);
+    object->spriteType = SSGE_SPRITE_SHARED;
+    object->shared.clock = id;
+    object->shared.phase = phase;
+    object->shared.instance = _HIDDEN(pos) ? UINT32_MAX : SSGE_Animation_AddInstance(id, _X(pos), _Y(pos), phase);
+}
+
+SSGEAPI void SSGE_Object_SetLayer(SSGE_Object *object, int16_t layer, uint16_t depth) {
+    object->layer = layer;
+    object->depth = depth;
+    switch (object->spriteType) {
+        case SSGE_SPRITE_ANIM:
+            SSGE_Animation_SetLayer(object->animation, layer, depth);
+            break;
+        case SSGE_SPRITE_STATIC:
+            _SSGE_RenderData *renderData = _spriteData(object);
+            if (renderData == NULL) break; // Hidden
+            invalidateLayer(renderData->layer);
+            renderData->layer = layer;
+            renderData->depth = depth;
+            markRenderDamage(renderData);
+            break;
+        default:
+            break;
+    }
 }
 
 SSGEAPI void SSGE_Object_RemoveSprite(SSGE_Object *object) {
+    _damageSprite(object);
     if (object->spriteType == SSGE_SPRITE_STATIC)
-        free(SSGE_Array_Pop(&object->texture.texture->queue, object->texture.renderDataIdx));
+        _removeSprite(object);
+    else if (object->spriteType == SSGE_SPRITE_SHARED)
+        _removeInstance(object);
     object->spriteType = SSGE_SPRITE_NONE;
 }
 
 SSGEAPI void SSGE_Object_Hide(SSGE_Object *object) {
-    if (object->hidden) return;
-    object->hidden = true;
+    uint32_t pos = _pos(object);
+    if (_HIDDEN(pos)) return;
+    _HIDDEN(pos) = true;
     switch (object->spriteType) {
         case SSGE_SPRITE_ANIM:
             SSGE_Animation_Pause(object->animation);
             break;
+        case SSGE_SPRITE_SHARED:
+            _removeInstance(object);
+            break;
         case SSGE_SPRITE_STATIC:
-            free(SSGE_Array_Pop(&object->texture.texture->queue, object->texture.renderDataIdx));
+            _damageSprite(object);
+            _removeSprite(object);
         default:
             break;
     }
 }
 
 SSGEAPI void SSGE_Object_Show(SSGE_Object *object) {
-    if (object->hidden) {
-        object->hidden = false;
+    uint32_t pos = _pos(object);
+    if (_HIDDEN(pos)) {
+        _HIDDEN(pos) = false;
         switch (object->spriteType) {
             case SSGE_SPRITE_ANIM:
                 SSGE_Animation_Resume(object->animation);
                 break;
+            case SSGE_SPRITE_SHARED:
+                object->shared.instance = addAnimationInstance(object->shared.clock, _X(pos), _Y(pos), object->shared.phase);
+                break;
             case SSGE_SPRITE_STATIC:
-                _SSGE_RenderData *renderData = (_SSGE_RenderData *)malloc(sizeof(_SSGE_RenderData));
-                *renderData = (_SSGE_RenderData){
-                    .dest = {
-                        .x = object->x,
-                        .y = object->y,
-                        .w = object->width,
-                        .h = object->height
-                    },
-                    .once = false
-                };
-                object->texture.renderDataIdx = SSGE_Array_Add(&object->texture.texture->queue, renderData);
+                _addSprite(object, pos);
+                _damageSprite(object);
                 break;
             default:
                 break;
@@ -176,7 +322,7 @@ SSGEAPI SSGE_Object *SSGE_Object_Get(uint32_t id) {
 }
 
 SSGEAPI SSGE_Object *SSGE_Object_GetName(const char *name) {
-    SSGE_Object *ptr = SSGE_Array_Find(&_objectList, _find_object_name, (void *)name);
+    SSGE_Object *ptr = SSGE_Array_GetName(&_objectList, name);
     if (ptr == NULL) 
         SSGE_ErrorEx("Object not found: %s", name)
     return ptr;
@@ -187,100 +333,125 @@ SSGEAPI void *SSGE_Object_GetData(SSGE_Object *object) {
 }
 
 SSGEAPI void SSGE_Object_Resize(SSGE_Object *object, uint16_t width, uint16_t height) {
-    object->width = width;
-    object->height = height;
+    uint32_t pos = _pos(object);
+    _WIDTH(pos) = width;
+    _HEIGHT(pos) = height;
     if (object->spriteType == SSGE_SPRITE_STATIC) {
-        _SSGE_RenderData *data = SSGE_Array_Get(&object->texture.texture->queue, object->texture.renderDataIdx);
+        _SSGE_RenderData *data = _spriteData(object);
+        if (data == NULL) return; // Hidden
+        markRenderDamage(data);
         data->dest.w = width;
         data->dest.h = height;
+        SSGE_Grid_Update(&_renderGrid, object->texture.gridNode, &data->dest);
+        markRenderDamage(data);
     }
 }
 
 SSGEAPI void SSGE_Object_Destroy(uint32_t id) {
-    SSGE_Object *object = SSGE_Array_Pop(&_objectList, id);
+    SSGE_Object *object = popObject(id);
     if (object == NULL)
         SSGE_ErrorEx("Object not found: %u", id)
     destroyObject(object);
 }
 
+SSGEAPI void SSGE_Object_DestroyBatch(const uint32_t *ids, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        SSGE_Object *object = popObject(ids[i]);
+        if (object == NULL)
+            SSGE_ErrorEx("Object not found: %u", ids[i])
+        destroyObject(object);
+    }
+}
+
 SSGEAPI void SSGE_Object_DestroyName(const char *name) {
-    SSGE_Object *object = SSGE_Array_FindPop(&_objectList, _find_object_name, (void *)name);
+    SSGE_Object *object = SSGE_Array_GetName(&_objectList, name);
     if (object == NULL) 
         SSGE_ErrorEx("Object not found: %s", name)
-    destroyObject(object);
+    destroyObject(popObject(object->id));
 }
 
 SSGEAPI void SSGE_Object_DestroyAll() {
     SSGE_Array_Destroy(&_objectList, (SSGE_DestroyData)destroyObject);
-    SSGE_Array_Create(&_objectList);
+    SSGE_Array_CreateSlotMap(&_objectList, _engine.objectCapacity);
+    SSGE_Array_IndexNames(&_objectList);
 }
 
 SSGEAPI bool SSGE_Object_IsColliding(SSGE_Object *hitbox1, SSGE_Object *hitbox2) {
-    if (!hitbox1->hitbox || !hitbox2->hitbox) return false;
-    return hitbox1->x < hitbox2->x + hitbox2->width && hitbox1->x + hitbox1->width > hitbox2->x && hitbox1->y < hitbox2->y + hitbox2->height && hitbox1->y + hitbox1->height > hitbox2->y;
+    uint32_t a = _pos(hitbox1), b = _pos(hitbox2);
+    if (!_HITBOX(a) || !_HITBOX(b)) return false;
+    return _X(a) < _X(b) + _WIDTH(b) && _X(a) + _WIDTH(a) > _X(b) && _Y(a) < _Y(b) + _HEIGHT(b) && _Y(a) + _HEIGHT(a) > _Y(b);
 }
 
-static bool _is_hovered(SSGE_Object *ptr, int *mousePos) {
-    int mouseX = mousePos[0],
-        mouseY = mousePos[1];
-    return mouseX >= ptr->x && mouseX <= ptr->x + ptr->width && mouseY >= ptr->y && mouseY <= ptr->y + ptr->height;
+/**
+ * Finds the objects containing a point
+ * \param x The x coordinate of the point
+ * \param y The y coordinate of the point
+ * \param objects Where to store the objects found
+ * \param size The maximum number of objects to store
+ * \return The number of objects stored
+ */
+static uint32_t _getAt(int x, int y, SSGE_Object *objects[], uint32_t size) {
+    uint32_t found[64];
+    uint32_t count = 0;
+
+    // Search by batches of 64 results so the positions fit on the stack
+    for (uint32_t first = 0; count < size;) {
+        uint32_t max = size - count < 64 ? size - count : 64;
+        uint32_t n = SSGE_Transforms_FindPoint(&_objectTransforms, first, _objectList.count, x, y, found, max);
+        for (uint32_t i = 0; i < n; i++)
+            objects[count++] = _objectList.array[found[i]];
+        if (n < max) break;
+        first = found[n - 1] + 1;
+    }
+    return count;
 }
 
 SSGEAPI bool SSGE_Object_IsHovered(SSGE_Object *object) {
     int mouseX, mouseY;
     SDL_GetMouseState(&mouseX, &mouseY);
-    return mouseX >= object->x && mouseX <= object->x + object->width && mouseY >= object->y && mouseY <= object->y + object->height;
+    SSGE_Camera_ScreenToWorld(mouseX, mouseY, &mouseX, &mouseY);
+    uint32_t pos = _pos(object);
+    return mouseX >= _X(pos) && mouseX <= _X(pos) + _WIDTH(pos) && mouseY >= _Y(pos) && mouseY <= _Y(pos) + _HEIGHT(pos);
 }
 
 SSGEAPI SSGE_Object *SSGE_Object_GetAt(int x, int y) {
-    int pos[2] = {x, y};
-    return SSGE_Array_Find(&_objectList, (bool (*)(void *, void *))_is_hovered, pos);
+    SSGE_Object *object;
+    return _getAt(x, y, &object, 1) ? object : NULL;
 }
 
 SSGEAPI uint32_t SSGE_Object_GetAtList(int x, int y, SSGE_Object *objects[], uint32_t size) {
-    int pos[2] = {x, y};
-
-    uint32_t i = 0, count = 0;
-    while (count < _objectList.count && i < _objectList.size && count < size) {
-        SSGE_Object *obj = SSGE_Array_Get(&_objectList, i++);
-
-        if (obj != NULL && _is_hovered(obj, pos))
-            objects[count++] = obj;
-    }
-    return count;
+    return _getAt(x, y, objects, size);
 }
 
 SSGEAPI SSGE_Object *SSGE_Object_GetHovered() {
-    int mousePos[2];
-    SDL_GetMouseState(&mousePos[0], &mousePos[1]);
+    int mouseX, mouseY;
+    SDL_GetMouseState(&mouseX, &mouseY);
+    SSGE_Camera_ScreenToWorld(mouseX, mouseY, &mouseX, &mouseY);
 
-    return SSGE_Array_Find(&_objectList, (bool (*)(void *, void *))_is_hovered, mousePos);
+    SSGE_Object *object;
+    return _getAt(mouseX, mouseY, &object, 1) ? object : NULL;
 }
 
 SSGEAPI uint32_t SSGE_Objects_GetHoveredList(SSGE_Object *objects[], uint32_t size) {
-    int mousePos[2];
-    SDL_GetMouseState(&mousePos[0], &mousePos[1]);
-    
-    uint32_t i = 0, count = 0;
-    while (count < _objectList.count && i < _objectList.size && count < size) {
-        SSGE_Object *obj = SSGE_Array_Get(&_objectList, i++);
-
-        if (obj != NULL && _is_hovered(obj, mousePos))
-            objects[count++] = obj;
-    }
-    return count;
+    int mouseX, mouseY;
+    SDL_GetMouseState(&mouseX, &mouseY);
+    SSGE_Camera_ScreenToWorld(mouseX, mouseY, &mouseX, &mouseY);
+
+    return _getAt(mouseX, mouseY, objects, size);
 }
 
 SSGEAPI void SSGE_Object_GetSize(SSGE_Object *object, uint16_t *width, uint16_t *height) {
-    *width = object->width;
-    *height = object->height;
+    uint32_t pos = _pos(object);
+    *width = _WIDTH(pos);
+    *height = _HEIGHT(pos);
 }
 
 SSGEAPI void SSGE_Object_GetPosition(SSGE_Object *object, int *x, int *y) {
-    *x = object->x;
-    *y = object->y;
+    uint32_t pos = _pos(object);
+    *x = _X(pos);
+    *y = _Y(pos);
 }
 
 SSGEAPI bool SSGE_Object_IsHidden(SSGE_Object *object) {
-    return object->hidden;
-}
+    return _HIDDEN(_pos(object));
+}
\ No newline at end of file
@@ -50,12 +50,8 @@ SSGEAPI SSGE_ObjectTemplate *SSGE_Template_Get(uint32_t id) {
     return ptr;
 }
 
-inline static bool _find_template_name(void *ptr, void *name) {
-    return strcmp(((SSGE_ObjectTemplate *)ptr)->name, name) == 0;
-}
-
 SSGEAPI SSGE_ObjectTemplate *SSGE_Template_GetName(const char *name) {
-    SSGE_ObjectTemplate *ptr = SSGE_Array_Find(&_objectTemplateList, _find_template_name, (void *)name);
+    SSGE_ObjectTemplate *ptr = SSGE_Array_GetName(&_objectTemplateList, name);
     if (ptr == NULL) 
         SSGE_ErrorEx("Object template not found: %s", name)
     return ptr;
@@ -65,19 +61,20 @@ SSGEAPI void SSGE_Template_Destroy(uint32_t id) {
     SSGE_ObjectTemplate *template = SSGE_Array_Pop(&_objectTemplateList, id);
     if (template == NULL) 
         SSGE_ErrorEx("Object template not found: %u", id)
-    free(template->name);
+    releaseName(template->name);
     free(template);
 }
 
 SSGEAPI void SSGE_Template_DestroyName(const char *name) {
-    SSGE_ObjectTemplate *template = SSGE_Array_FindPop(&_objectTemplateList, _find_template_name, (void *)name);
+    SSGE_ObjectTemplate *template = SSGE_Array_PopName(&_objectTemplateList, name);
     if (template == NULL) 
         SSGE_ErrorEx("Object template not found: %s", name)
-    free(template->name);
+    releaseName(template->name);
     free(template);
 }
 
 SSGEAPI void SSGE_Template_DestroyAll() {
     SSGE_Array_Destroy(&_objectTemplateList, (SSGE_DestroyData)destroyTemplate);
-    SSGE_Array_Create(&_objectTemplateList);
+    SSGE_Array_CreateSlotMap(&_objectTemplateList, _LIST_INITIAL_SIZE);
+    SSGE_Array_IndexNames(&_objectTemplateList);
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include <stdlib.h>
+#include <stddef.h>
+
+#include "SSGE_local.h"
+#include "SSGE_error.h"
+
+#define _ALIGNMENT          _Alignof(max_align_t)
+#define _ALIGN(size)        (((size) + _ALIGNMENT - 1) & ~(size_t)(_ALIGNMENT - 1))
+#define _SLABS_INITIAL_SIZE 4
+#define _GROWTH_FACTOR      2
+
+/**
+ * Creates a pool
+ * \param pool The pool to initialize
+ * \param blockSize The size of a block
+ * \param slabBlocks The number of blocks allocated at once
+ */
+SSGEAPI void SSGE_Pool_Create(_SSGE_Pool *pool, size_t blockSize, uint32_t slabBlocks) {
+    pool->slabs = (void **)malloc(sizeof(void *) * _SLABS_INITIAL_SIZE);
+    if (pool->slabs == NULL)
+        SSGE_Error("Failed to allocate memory for pool")
+    pool->slabCount = 0;
+    pool->slabSize = _SLABS_INITIAL_SIZE;
+    pool->blockSize = _ALIGN(blockSize < sizeof(void *) ? sizeof(void *) : blockSize);
+    pool->slabBlocks = slabBlocks;
+    pool->slabUsed = slabBlocks; // No slab yet
+    pool->freeList = NULL;
+}
+
+/**
+ * Allocates a block from a pool
+ * \param pool The pool
+ * \return The block, aligned for any type
+ */
+SSGEAPI void *SSGE_Pool_Alloc(_SSGE_Pool *pool) {
+    if (pool->freeList != NULL) {
+        void *block = pool->freeList;
+        pool->freeList = *(void **)block;
+        return block;
+    }
+
+    if (pool->slabUsed == pool->slabBlocks) {
+        if (pool->slabCount == pool->slabSize) {
+            pool->slabSize = pool->slabSize ? pool->slabSize * _GROWTH_FACTOR : _SLABS_INITIAL_SIZE;
+            void **slabs = (void **)realloc(pool->slabs, sizeof(void *) * pool->slabSize);
+            if (slabs == NULL)
+                SSGE_Error("Failed to reallocate memory for pool")
+            pool->slabs = slabs;
+        }
+        void *slab = malloc(pool->blockSize * pool->slabBlocks);
+        if (slab == NULL)
+            SSGE_Error("Failed to allocate memory for pool slab")
+        pool->slabs[pool->slabCount++] = slab;
+        pool->slabUsed = 0;
+    }
+
+    return (uint8_t *)pool->slabs[pool->slabCount - 1] + pool->blockSize * pool->slabUsed++;
+}
+
+/**
+ * Gives a block back to a pool
+ * \param pool The pool
+ * \param block The block returned by `SSGE_Pool_Alloc`
+ */
+SSGEAPI void SSGE_Pool_Free(_SSGE_Pool *pool, void *block) {
+    *(void **)block = pool->freeList;
+    pool->freeList = block;
+}
+
+/**
+ * Destroys a pool and every block allocated from it
+ * \param pool The pool to destroy
+ */
+SSGEAPI void SSGE_Pool_Destroy(_SSGE_Pool *pool) {
+    for (uint32_t i = 0; i < pool->slabCount; i++)
+        free(pool->slabs[i]);
+    free(pool->slabs);
+    pool->slabs = NULL;
+    pool->slabCount = 0;
+    pool->slabSize = 0;
+    pool->slabUsed = pool->slabBlocks;
+    pool->freeList = NULL;
+}
@@ -0,0 +1,53 @@
+// Internal pool (fixed-size block allocator) functions
+
+#ifndef __SSGE_POOL_H__
+#define __SSGE_POOL_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern _SSGE_Pool _objectPool;
+extern _SSGE_Pool _animStatePool;
+extern _SSGE_Pool _namePool;
+
+/**
+ * Create a pool
+ * \param pool The pool to initialize
+ * \param blockSize The size of a block
+ * \param slabBlocks The number of blocks allocated at once
+ */
+SSGEAPI void SSGE_Pool_Create(_SSGE_Pool *pool, size_t blockSize, uint32_t slabBlocks);
+
+/**
+ * Allocate a block from a pool
+ * \param pool The pool
+ * \return The block, aligned for any type
+ * \note Freed blocks are reused first, then blocks are taken in order from the last slab
+ */
+SSGEAPI void *SSGE_Pool_Alloc(_SSGE_Pool *pool);
+
+/**
+ * Give a block back to a pool
+ * \param pool The pool
+ * \param block The block returned by `SSGE_Pool_Alloc`
+ */
+SSGEAPI void SSGE_Pool_Free(_SSGE_Pool *pool, void *block);
+
+/**
+ * Destroy a pool and every block allocated from it
+ * \param pool The pool to destroy
+ */
+SSGEAPI void SSGE_Pool_Destroy(_SSGE_Pool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_POOL_H__
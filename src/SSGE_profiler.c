@@ -0,0 +1,144 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SSGE_local.h"
+#include "SSGE/SSGE_profiler.h"
+#include "SDL2_gfxPrimitives.h"
+
+#define _OVERLAY_X          4
+#define _OVERLAY_Y          4
+#define _GRAPH_HEIGHT       64
+#define _GRAPH_SCALE        2   // Pixels per millisecond
+#define _LINE_HEIGHT        10  // The gfx font is 8 pixels high
+#define _OVERLAY_WIDTH      252 // A line of statistics is 31 characters of 8 pixels
+
+static const char *_phaseNames[SSGE_PHASE_COUNT] = {
+    "events", "update", "clear", "background", "textures", "animations", "submit", "draw", "present", "frame"
+};
+
+SSGEAPI void SSGE_Profiler_Enable(bool enabled) {
+    if (enabled && !_profiler.enabled) {
+        _profiler.next = 0;
+        _profiler.count = 0;
+    }
+    _profiler.enabled = enabled;
+    if (!enabled) _profiler.overlay = false;
+}
+
+static int _compareTicks(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+SSGEAPI bool SSGE_Profiler_GetStats(SSGE_ProfilePhase phase, SSGE_PhaseStats *stats) {
+    if (_profiler.count == 0) return false;
+
+    uint64_t ticks[_SSGE_PROFILER_FRAMES];
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < _profiler.count; i++) {
+        ticks[i] = _profiler.frames[i][phase];
+        sum += ticks[i];
+    }
+    qsort(ticks, _profiler.count, sizeof(uint64_t), _compareTicks);
+
+    double toMs = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    uint32_t p99 = (_profiler.count * 99 + 99) / 100 - 1; // Nearest rank
+    stats->min = (double)ticks[0] * toMs;
+    stats->avg = (double)sum * toMs / (double)_profiler.count;
+    stats->p99 = (double)ticks[p99] * toMs;
+    return true;
+}
+
+SSGEAPI void SSGE_Profiler_ShowOverlay(bool show) {
+    if (show) SSGE_Profiler_Enable(true);
+    _profiler.overlay = show;
+}
+
+/**
+ * Starts profiling a frame
+ */
+void profileBegin() {
+    if (!_profiler.enabled && !_trace.enabled) return;
+    memset(_profiler.current, 0, sizeof(_profiler.current));
+    _profiler.start = _profiler.last = SDL_GetPerformanceCounter();
+}
+
+/**
+ * Adds the time elapsed since the last mark to a phase of the current frame
+ * \param phase The phase that just ended
+ */
+void profileMark(SSGE_ProfilePhase phase) {
+    if (!_profiler.enabled && !_trace.enabled) return;
+    uint64_t now = SDL_GetPerformanceCounter();
+    _profiler.current[phase] += now - _profiler.last;
+    traceZone(_phaseNames[phase], _profiler.last, now);
+    _profiler.last = now;
+}
+
+/**
+ * Leaves the time elapsed since the last mark out of the current frame
+ */
+void profileSkip() {
+    if (!_profiler.enabled && !_trace.enabled) return;
+    _profiler.last = SDL_GetPerformanceCounter();
+}
+
+/**
+ * Records the current frame in the ring buffer, and in the trace
+ */
+void profileEnd() {
+    traceZone(_phaseNames[SSGE_PHASE_FRAME], _profiler.start, _profiler.last);
+    if (!_profiler.enabled) return;
+    uint64_t *frame = _profiler.frames[_profiler.next];
+    memcpy(frame, _profiler.current, sizeof(_profiler.current));
+    frame[SSGE_PHASE_FRAME] = 0;
+    for (int i = 0; i < SSGE_PHASE_FRAME; i++)
+        frame[SSGE_PHASE_FRAME] += frame[i];
+
+    _profiler.next = (_profiler.next + 1) % _SSGE_PROFILER_FRAMES;
+    if (_profiler.count < _SSGE_PROFILER_FRAMES) ++_profiler.count;
+}
+
+/**
+ * Draws the profiler overlay, if shown
+ */
+void profileOverlay() {
+    if (!_profiler.overlay) return;
+    profileMark(SSGE_PHASE_DRAW);
+
+    SDL_Renderer *renderer = _engine.renderer;
+    int width = _SSGE_PROFILER_FRAMES * 2;
+    int height = _GRAPH_HEIGHT + 4 + _LINE_HEIGHT * (SSGE_PHASE_COUNT + 1);
+    boxRGBA(renderer, _OVERLAY_X, _OVERLAY_Y, _OVERLAY_X + _OVERLAY_WIDTH, _OVERLAY_Y + height + 4, 0, 0, 0, 192);
+
+    // Frame time graph, oldest frame on the left, with the target frame time as a line
+    double toPixels = 1000.0 * _GRAPH_SCALE / (double)SDL_GetPerformanceFrequency();
+    int bottom = _OVERLAY_Y + 2 + _GRAPH_HEIGHT;
+    for (uint32_t i = 0; i < _profiler.count; i++) {
+        uint32_t frame = (_profiler.next + _SSGE_PROFILER_FRAMES - _profiler.count + i) % _SSGE_PROFILER_FRAMES;
+        int bar = (int)((double)_profiler.frames[frame][SSGE_PHASE_FRAME] * toPixels);
+        if (bar > _GRAPH_HEIGHT) bar = _GRAPH_HEIGHT;
+        int x = _OVERLAY_X + 2 + (int)i * 2;
+        vlineRGBA(renderer, x, bottom - bar, bottom, 64, 224, 64, 255);
+    }
+    int target = (int)(1000.0 * _GRAPH_SCALE / (double)_engine.fps);
+    if (target <= _GRAPH_HEIGHT)
+        hlineRGBA(renderer, _OVERLAY_X + 2, _OVERLAY_X + 2 + width, bottom - target, 224, 64, 64, 255);
+
+    char line[64];
+    int y = bottom + 4;
+    snprintf(line, sizeof(line), "%-11s%6s %6s %6s", "phase", "min", "avg", "p99");
+    stringRGBA(renderer, _OVERLAY_X + 2, y, line, 255, 255, 255, 255);
+    for (int i = 0; i < SSGE_PHASE_COUNT; i++) {
+        SSGE_PhaseStats stats;
+        if (!SSGE_Profiler_GetStats((SSGE_ProfilePhase)i, &stats)) break;
+        y += _LINE_HEIGHT;
+        snprintf(line, sizeof(line), "%-11s%6.2f %6.2f %6.2f", _phaseNames[i], stats.min, stats.avg, stats.p99);
+        stringRGBA(renderer, _OVERLAY_X + 2, y, line, 255, 255, 255, 255);
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, _color.r, _color.g, _color.b, _color.a);
+    profileSkip();
+}
@@ -0,0 +1,220 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "SSGE_local.h"
+#include "SSGE_error.h"
+
+#define _QUEUE_INITIAL_SIZE 4
+#define _GROWTH_FACTOR 2
+
+/**
+ * Creates a render queue
+ * \param queue The render queue to initialize
+ */
+SSGEAPI void SSGE_RenderQueue_Create(_SSGE_RenderQueue *queue) {
+    // Nothing is allocated until the queue is used
+    queue->persistent = NULL;
+    queue->persistentCount = 0;
+    queue->persistentSize = 0;
+    SSGE_SlotTable_Create(&queue->slots, 0, 0); // The ids never leave the engine, the slots are reused immediately
+
+    queue->once = queue->onceInline;
+    queue->onceCount = 0;
+    queue->onceSize = _SSGE_RENDER_QUEUE_INLINE_SIZE;
+}
+
+/**
+ * Reserves space for persistent render data that will be added to a render queue
+ * \param queue The render queue
+ * \param count The number of render data that will be added
+ */
+SSGEAPI void SSGE_RenderQueue_Reserve(_SSGE_RenderQueue *queue, uint32_t count) {
+    uint32_t size = queue->persistentSize ? queue->persistentSize : _QUEUE_INITIAL_SIZE;
+    while (size - queue->persistentCount < count)
+        size *= _GROWTH_FACTOR;
+    if (size == queue->persistentSize) return;
+
+    _SSGE_RenderData *persistent = (_SSGE_RenderData *)realloc(queue->persistent, sizeof(_SSGE_RenderData) * size);
+    if (persistent == NULL)
+        SSGE_Error("Failed to realloc render queue")
+    queue->persistent = persistent;
+    queue->persistentSize = size;
+    SSGE_SlotTable_Grow(&queue->slots, size);
+}
+
+/**
+ * Adds a persistent render data to a render queue
+ * \param queue The render queue
+ * \param data The render data, copied in the queue
+ * \return The id of the render data
+ */
+SSGEAPI uint32_t SSGE_RenderQueue_Add(_SSGE_RenderQueue *queue, const _SSGE_RenderData *data) {
+    if (queue->persistentSize <= queue->persistentCount)
+        SSGE_RenderQueue_Reserve(queue, 1);
+
+    queue->persistent[queue->persistentCount] = *data;
+    return SSGE_SlotTable_Alloc(&queue->slots, queue->persistentCount++);
+}
+
+/**
+ * Gets a persistent render data from a render queue
+ * \param queue The render queue
+ * \param id The id of the render data
+ * \return The pointer to the render data, or NULL if not found
+ */
+SSGEAPI _SSGE_RenderData *SSGE_RenderQueue_Get(_SSGE_RenderQueue *queue, uint32_t id) {
+    uint32_t pos = SSGE_SlotTable_Resolve(&queue->slots, queue->persistentCount, id);
+    if (pos == UINT32_MAX) return NULL;
+    return &queue->persistent[pos];
+}
+
+/**
+ * Removes a persistent render data from a render queue
+ * \param queue The render queue
+ * \param id The id of the render data
+ */
+SSGEAPI void SSGE_RenderQueue_Remove(_SSGE_RenderQueue *queue, uint32_t id) {
+    uint32_t pos = SSGE_SlotTable_Resolve(&queue->slots, queue->persistentCount, id);
+    if (pos == UINT32_MAX) return;
+
+    uint32_t last = --queue->persistentCount;
+    SSGE_SlotTable_Free(&queue->slots, pos, last);
+    queue->persistent[pos] = queue->persistent[last];
+}
+
+/**
+ * Pushes a render data to be drawn on the next frame only
+ * \param queue The render queue
+ * \param data The render data, copied in the queue
+ */
+SSGEAPI void SSGE_RenderQueue_Push(_SSGE_RenderQueue *queue, const _SSGE_RenderData *data) {
+    if (queue->onceSize <= queue->onceCount) {
+        if (queue->onceSize > UINT32_MAX / _GROWTH_FACTOR)
+            SSGE_Error("Render queue size would overflow")
+        bool isInline = queue->once == queue->onceInline;
+        _SSGE_RenderData *once = (_SSGE_RenderData *)realloc(isInline ? NULL : queue->once, sizeof(_SSGE_RenderData) * queue->onceSize * _GROWTH_FACTOR);
+        if (once == NULL)
+            SSGE_Error("Failed to realloc render queue")
+        if (isInline)
+            memcpy(once, queue->onceInline, sizeof(queue->onceInline));
+        queue->once = once;
+        queue->onceSize *= _GROWTH_FACTOR;
+    }
+
+    queue->once[queue->onceCount++] = *data;
+}
+
+/**
+ * Destroys a render queue
+ * \param queue The render queue to destroy
+ */
+SSGEAPI void SSGE_RenderQueue_Destroy(_SSGE_RenderQueue *queue) {
+    free(queue->persistent);
+    SSGE_SlotTable_Destroy(&queue->slots);
+    if (queue->once != queue->onceInline)
+        free(queue->once);
+}
+
+/**
+ * Starts the command queue of a frame
+ * \param queue The command queue
+ * \param size The maximum number of render commands of the frame
+ */
+SSGEAPI void SSGE_CommandQueue_Begin(_SSGE_CommandQueue *queue, uint32_t size) {
+    queue->commands = size ? (_SSGE_RenderCommand *)SSGE_Arena_Alloc(&_frameArena, sizeof(_SSGE_RenderCommand) * size) : NULL;
+    queue->count = 0;
+    queue->size = size;
+    queue->lastTexture = NULL;
+    queue->blendKey = 0;
+}
+
+/**
+ * Pushes a render command to a command queue
+ * \param queue The command queue
+ * \param texture The texture to draw
+ * \param textureKey The texture part of the sort key
+ * \param src The source rect in the texture, NULL for the whole texture
+ * \param data The render data, must stay valid until the queue is submitted
+ */
+SSGEAPI void SSGE_CommandQueue_Push(_SSGE_CommandQueue *queue, SDL_Texture *texture, uint32_t textureKey, const SDL_Rect *src, const _SSGE_RenderData *data) {
+    if (queue->count >= queue->size)
+        SSGE_Error("Command queue is full")
+
+    if (texture != queue->lastTexture) {
+        SDL_BlendMode mode = SDL_BLENDMODE_BLEND;
+        SDL_GetTextureBlendMode(texture, &mode);
+        queue->lastTexture = texture;
+        queue->blendKey = (uint8_t)mode;
+    }
+
+    uint64_t layer = (uint16_t)((int32_t)data->layer + 32768); // Negative layers sort first
+    queue->commands[queue->count++] = (_SSGE_RenderCommand){
+        .key = layer << 48 | (uint64_t)data->depth << 32 | (uint64_t)(textureKey & 0xFFFFFF) << 8 | queue->blendKey,
+        .texture = texture,
+        .src = src,
+        .data = data
+    };
+}
+
+/**
+ * Sorts the render commands of a command queue by their sort key
+ * \param queue The command queue
+ */
+SSGEAPI void SSGE_CommandQueue_Sort(_SSGE_CommandQueue *queue) {
+    uint32_t count = queue->count;
+    if (count < 2) return;
+
+    // One histogram pass for the 8 bytes of the keys
+    uint32_t histograms[8][256] = {0};
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t key = queue->commands[i].key;
+        for (int byte = 0; byte < 8; byte++)
+            ++histograms[byte][(key >> (byte * 8)) & 0xFF];
+    }
+
+    void *mark = SSGE_Arena_Alloc(&_frameArena, sizeof(_SSGE_RenderCommand) * count);
+    _SSGE_RenderCommand *from = queue->commands, *to = (_SSGE_RenderCommand *)mark;
+
+    // Stable LSD radix sort, skipping the bytes every key shares
+    for (int byte = 0; byte < 8; byte++) {
+        uint32_t *histogram = histograms[byte];
+        int shift = byte * 8;
+        if (histogram[(from[0].key >> shift) & 0xFF] == count) continue;
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++) {
+            uint32_t n = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += n;
+        }
+        for (uint32_t i = 0; i < count; i++)
+            to[histogram[(from[i].key >> shift) & 0xFF]++] = from[i];
+
+        _SSGE_RenderCommand *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != queue->commands)
+        memcpy(queue->commands, from, sizeof(_SSGE_RenderCommand) * count);
+    SSGE_Arena_Rewind(&_frameArena, mark);
+}
+
+/**
+ * Submits the render commands of a command queue to a sprite batch
+ * \param queue The command queue
+ * \param batch The sprite batch
+ * \param clip The region to draw, NULL for the whole window
+ */
+SSGEAPI void SSGE_CommandQueue_Submit(_SSGE_CommandQueue *queue, _SSGE_SpriteBatch *batch, const SDL_Rect *clip) {
+    for (uint32_t i = 0; i < queue->count; i++) {
+        const _SSGE_RenderData *data = queue->commands[i].data;
+
+        // Rotated commands may reach outside their dest rect, they are left to the clip rect
+        if (clip != NULL && data->angle == 0 && (data->dest.x >= clip->x + clip->w || data->dest.x + data->dest.w <= clip->x
+            || data->dest.y >= clip->y + clip->h || data->dest.y + data->dest.h <= clip->y)) continue;
+
+        SSGE_SpriteBatch_Push(batch, queue->commands[i].texture, queue->commands[i].src, data);
+    }
+    SSGE_SpriteBatch_Flush(batch);
+}
@@ -0,0 +1,110 @@
+// Internal render queue functions
+
+#ifndef __SSGE_RENDER_H__
+#define __SSGE_RENDER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern _SSGE_CommandQueue _renderCommands;
+
+/**
+ * Create a render queue
+ * \param queue The render queue to initialize
+ * \note Nothing is allocated until the queue is used, the first one-shot render data are stored inline
+ * \warning The queue must not be moved in memory, its one-shot region may point into it
+ */
+SSGEAPI void SSGE_RenderQueue_Create(_SSGE_RenderQueue *queue);
+
+/**
+ * Reserve space for persistent render data that will be added to a render queue
+ * \param queue The render queue
+ * \param count The number of render data that will be added
+ */
+SSGEAPI void SSGE_RenderQueue_Reserve(_SSGE_RenderQueue *queue, uint32_t count);
+
+/**
+ * Add a persistent render data to a render queue
+ * \param queue The render queue
+ * \param data The render data, copied in the queue
+ * \return The id of the render data
+ * \note Persistent render data is drawn every frame until it is removed
+ */
+SSGEAPI uint32_t SSGE_RenderQueue_Add(_SSGE_RenderQueue *queue, const _SSGE_RenderData *data);
+
+/**
+ * Get a persistent render data from a render queue
+ * \param queue The render queue
+ * \param id The id of the render data
+ * \return The pointer to the render data, or NULL if not found
+ * \warning The pointer is invalidated when a render data is added to or removed from the queue
+ */
+SSGEAPI _SSGE_RenderData *SSGE_RenderQueue_Get(_SSGE_RenderQueue *queue, uint32_t id);
+
+/**
+ * Remove a persistent render data from a render queue
+ * \param queue The render queue
+ * \param id The id of the render data
+ * \note Does nothing if the render data is not in the queue
+ */
+SSGEAPI void SSGE_RenderQueue_Remove(_SSGE_RenderQueue *queue, uint32_t id);
+
+/**
+ * Push a render data to be drawn on the next frame only
+ * \param queue The render queue
+ * \param data The render data, copied in the queue
+ */
+SSGEAPI void SSGE_RenderQueue_Push(_SSGE_RenderQueue *queue, const _SSGE_RenderData *data);
+
+/**
+ * Destroy a render queue
+ * \param queue The render queue to destroy
+ */
+SSGEAPI void SSGE_RenderQueue_Destroy(_SSGE_RenderQueue *queue);
+
+/**
+ * Start the command queue of a frame
+ * \param queue The command queue
+ * \param size The maximum number of render commands of the frame
+ * \note The commands are allocated in the frame arena
+ */
+SSGEAPI void SSGE_CommandQueue_Begin(_SSGE_CommandQueue *queue, uint32_t size);
+
+/**
+ * Push a render command to a command queue
+ * \param queue The command queue
+ * \param texture The texture to draw
+ * \param textureKey The texture part of the sort key, the same for every command drawing from `texture`
+ * \param src The source rect in the texture, NULL for the whole texture
+ * \param data The render data, must stay valid until the queue is submitted
+ */
+SSGEAPI void SSGE_CommandQueue_Push(_SSGE_CommandQueue *queue, SDL_Texture *texture, uint32_t textureKey, const SDL_Rect *src, const _SSGE_RenderData *data);
+
+/**
+ * Sort the render commands of a command queue by their sort key
+ * \param queue The command queue
+ * \note The sort is stable, commands with the same key keep their push order
+ */
+SSGEAPI void SSGE_CommandQueue_Sort(_SSGE_CommandQueue *queue);
+
+/**
+ * Submit the render commands of a command queue to a sprite batch
+ * \param queue The command queue
+ * \param batch The sprite batch
+ * \param clip The region to draw, NULL for the whole window
+ * \note The commands are kept until the next `SSGE_CommandQueue_Begin`, so they can be submitted once per region
+ */
+SSGEAPI void SSGE_CommandQueue_Submit(_SSGE_CommandQueue *queue, _SSGE_SpriteBatch *batch, const SDL_Rect *clip);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_RENDER_H__
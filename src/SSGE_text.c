@@ -1,7 +1,118 @@
 #include "SSGE_local.h"
 #include "SSGE/SSGE_text.h"
+#include "SSGE/SSGE_trace.h"
+
+#define _TEXT_CACHE_SIZE 128 // Must be a power of 2
+
+// Text rendered by SSGE_Text_Draw, kept while it is drawn every frame
+typedef struct _SSGE_TextCacheEntry {
+    TTF_Font    *font;
+    SSGE_Color  color;
+    uint32_t    hash;
+    bool        used;
+    char        *text;
+    SDL_Texture *texture;
+    int         w, h;
+} _SSGE_TextCacheEntry;
+
+static _SSGE_TextCacheEntry _textCache[_TEXT_CACHE_SIZE] = {0};
+static uint32_t _textCacheCount = 0;
+
+static uint32_t _textHash(TTF_Font *font, const char *text, SSGE_Color color) {
+    uint32_t hash = 2166136261u;
+    uintptr_t key = (uintptr_t)font;
+    for (size_t i = 0; i < sizeof(key); i++, key >>= 8)
+        hash = (hash ^ (uint8_t)key) * 16777619u;
+    for (int i = 0; i < 4; i++)
+        hash = (hash ^ ((uint8_t *)&color)[i]) * 16777619u;
+    for (; *text; text++)
+        hash = (hash ^ (uint8_t)*text) * 16777619u;
+    return hash;
+}
+
+static void _textCacheErase(uint32_t pos) {
+    _SSGE_TextCacheEntry *entry = &_textCache[pos];
+    SDL_DestroyTexture(entry->texture);
+    free(entry->text);
+    entry->texture = NULL;
+    _textCacheCount--;
+
+    // Backward shift the following entries of the cluster
+    uint32_t next = pos;
+    while (true) {
+        next = (next + 1) & (_TEXT_CACHE_SIZE - 1);
+        if (_textCache[next].texture == NULL) break;
+        uint32_t home = _textCache[next].hash & (_TEXT_CACHE_SIZE - 1);
+        if (((next - home) & (_TEXT_CACHE_SIZE - 1)) >= ((next - pos) & (_TEXT_CACHE_SIZE - 1))) {
+            _textCache[pos] = _textCache[next];
+            _textCache[next].texture = NULL;
+            pos = next;
+        }
+    }
+}
+
+void flushTextCache(bool all) {
+    for (uint32_t i = 0; i < _TEXT_CACHE_SIZE && _textCacheCount > 0; i++)
+        while (_textCache[i].texture != NULL && (all || !_textCache[i].used))
+            _textCacheErase(i);
+    for (uint32_t i = 0; i < _TEXT_CACHE_SIZE; i++)
+        _textCache[i].used = false;
+}
+
+/**
+ * Render text, reusing the texture rendered for the same text during the previous frame
+ * \param font The font to use
+ * \param text The text to render
+ * \param color The color of the text
+ * \param w Where to store the width of the text
+ * \param h Where to store the height of the text
+ * \param cached Where to store if the texture belongs to the cache
+ * \return The texture of the text
+ */
+static SDL_Texture *_renderText(TTF_Font *font, const char *text, SSGE_Color color, int *w, int *h, bool *cached) {
+    uint32_t hash = _textHash(font, text, color);
+    uint32_t pos = hash & (_TEXT_CACHE_SIZE - 1);
+    for (; _textCache[pos].texture != NULL; pos = (pos + 1) & (_TEXT_CACHE_SIZE - 1)) {
+        _SSGE_TextCacheEntry *entry = &_textCache[pos];
+        if (entry->hash == hash && entry->font == font && *(uint32_t *)&entry->color == *(uint32_t *)&color && strcmp(entry->text, text) == 0) {
+            entry->used = true;
+            *w = entry->w;
+            *h = entry->h;
+            *cached = true;
+            return entry->texture;
+        }
+    }
+
+    SSGE_Trace_Begin("SSGE_Text_Draw (render)");
+    SDL_Surface *surface = TTF_RenderText_Solid(font, text, *(SDL_Color *)&color);
+    if (surface == NULL) 
+        SSGE_ErrorEx("Failed to draw text: %s", TTF_GetError())
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(_engine.renderer, surface);
+    if (texture == NULL)
+        SSGE_ErrorEx("Failed to draw text: %s", SDL_GetError())
+
+    *w = surface->w;
+    *h = surface->h;
+    SDL_FreeSurface(surface);
+    SSGE_Trace_End();
+
+    // Keep the load factor under 3/4, the texture is destroyed after the draw otherwise
+    *cached = _textCacheCount < _TEXT_CACHE_SIZE / 4 * 3;
+    if (*cached) {
+        char *copy = (char *)malloc(strlen(text) + 1);
+        if (copy == NULL)
+            SSGE_Error("Failed to allocate memory for text cache")
+        strcpy(copy, text);
+
+        _textCache[pos] = (_SSGE_TextCacheEntry){font, color, hash, true, copy, texture, *w, *h};
+        _textCacheCount++;
+    }
+    return texture;
+}
 
 SSGEAPI void SSGE_Font_Create(const char *name, const char *filename, int size) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Font *font = (SSGE_Font *)malloc(sizeof(SSGE_Font));
     if (font == NULL) 
         SSGE_Error("Failed to allocate memory for font")
@@ -10,20 +121,14 @@ SSGEAPI void SSGE_Font_Create(const char *name, const char *filename, int size)
     if (font->font == NULL) 
         SSGE_ErrorEx("Failed to load font: %s", TTF_GetError())
 
-    font->name = (char *)malloc(sizeof(char) * strlen(filename) + 1);
-    if (font->name == NULL) 
-        SSGE_Error("Failed to allocate memory for font name")
-    strcpy(font->name, name);
+    font->name = (char *)SSGE_Intern_Acquire(name);
 
     SSGE_Array_Add(&_fontList, font);
-}
-
-inline static bool _find_font_name(void *ptr, void *name) {
-    return strcmp(((SSGE_Font *)ptr)->name, (char *)name) == 0;
+    SSGE_Trace_End();
 }
 
 static SSGE_Font *_get_font(const char *name, char *funcname) {
-    SSGE_Font *ptr = SSGE_Array_Find(&_fontList, _find_font_name, (void *)name);
+    SSGE_Font *ptr = SSGE_Array_GetName(&_fontList, name);
     if (ptr == NULL) {
         fprintf(stderr, "[SSGE][%s] Font not found: %s\n", funcname, name);
         exit(1);
@@ -32,15 +137,18 @@ static SSGE_Font *_get_font(const char *name, char *funcname) {
 }
 
 SSGEAPI void SSGE_Font_Close(const char *name) {
-    SSGE_Font *font = SSGE_Array_FindPop(&_fontList, _find_font_name, (void *)name);
+    SSGE_Font *font = SSGE_Array_PopName(&_fontList, name);
     if (font == NULL) 
         SSGE_ErrorEx("Font not found: %s", name)
+    flushTextCache(true);
     destroyFont(font);
 }
 
 SSGEAPI void SSGE_Font_CloseAll() {
+    flushTextCache(true);
     SSGE_Array_Destroy(&_fontList, (SSGE_DestroyData)destroyFont);
-    SSGE_Array_Create(&_fontList);
+    SSGE_Array_CreateSlotMap(&_fontList, _LIST_INITIAL_SIZE);
+    SSGE_Array_IndexNames(&_fontList);
 }
 
 SSGEAPI void SSGE_Text_Draw(const char *fontName, const char *text, int x, int y, SSGE_Color color, SSGE_Anchor anchor) {
@@ -51,55 +159,52 @@ SSGEAPI void SSGE_Text_Draw(const char *fontName, const char *text, int x, int y
     if (font == NULL)
         SSGE_ErrorEx("Font not found: %s", fontName)
 
-    SDL_Surface *surface = TTF_RenderText_Solid(font->font, text, *(SDL_Color *)&color);
-    if (surface == NULL) 
-        SSGE_ErrorEx("Failed to draw text: %s", TTF_GetError())
+    int w, h;
+    bool cached;
+    SDL_Texture *texture = _renderText(font->font, text, color, &w, &h, &cached);
 
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(_engine.renderer, surface);
-    if (texture == NULL)
-        SSGE_ErrorEx("Failed to draw text: %s", SDL_GetError())
-
-    SDL_Rect rect = {x, y, surface->w, surface->h};
+    SDL_Rect rect = {x, y, w, h};
     switch (anchor) {
         case SSGE_NW:
             break;
         case SSGE_N:
-            rect.x -= surface->w / 2;
+            rect.x -= w / 2;
             break;
         case SSGE_NE:
-            rect.x -= surface->w;
+            rect.x -= w;
             break;
         case SSGE_W:
-            rect.y -= surface->h / 2;
+            rect.y -= h / 2;
             break;
         case SSGE_CENTER:
-            rect.x -= surface->w / 2;
-            rect.y -= surface->h / 2;
+            rect.x -= w / 2;
+            rect.y -= h / 2;
             break;
         case SSGE_E:
-            rect.x -= surface->w;
-            rect.y -= surface->h / 2;
+            rect.x -= w;
+            rect.y -= h / 2;
             break;
         case SSGE_SW:
-            rect.y -= surface->h;
+            rect.y -= h;
             break;
         case SSGE_S:
-            rect.x -= surface->w / 2;
-            rect.y -= surface->h;
+            rect.x -= w / 2;
+            rect.y -= h;
             break;
         case SSGE_SE:
-            rect.x -= surface->w;
-            rect.y -= surface->h;
+            rect.x -= w;
+            rect.y -= h;
             break;
     }
 
     SDL_RenderCopy(_engine.renderer, texture, NULL, &rect);
 
-    SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
+    if (!cached)
+        SDL_DestroyTexture(texture);
 }
 
 SSGEAPI SSGE_Texture *SSGE_Text_Create(uint32_t *id, const char *textureName, const char *fontName, const char *text, SSGE_Color color) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -122,11 +227,9 @@ SSGEAPI SSGE_Texture *SSGE_Text_Create(uint32_t *id, const char *textureName, co
         texture->texture = SDL_CreateTexture(_engine.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, _engine.width, _engine.height);
     }
 
-    texture->anchorX = 0;
-    texture->anchorY = 0;
-
-    SSGE_Array_Create(&texture->queue);
+    _initTextureFields(texture);
 
     _addToList(&_textureList, texture, textureName, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
\ No newline at end of file
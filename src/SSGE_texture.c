@@ -1,7 +1,9 @@
 #include "SSGE_local.h"
 #include "SSGE/SSGE_texture.h"
+#include "SSGE/SSGE_trace.h"
 
 SSGEAPI SSGE_Texture *SSGE_Texture_Create(uint32_t *id, const char *name, const char *filename) {
+    SSGE_Trace_Begin(__func__);
     SSGE_Texture *texture = (SSGE_Texture *)malloc(sizeof(SSGE_Texture));
     if (texture == NULL) 
         SSGE_Error("Failed to allocate memory for texture")
@@ -13,6 +15,7 @@ SSGEAPI SSGE_Texture *SSGE_Texture_Create(uint32_t *id, const char *name, const
     _initTextureFields(texture);
 
     _addToList(&_textureList, texture, name, id, __func__);
+    SSGE_Trace_End();
     return texture;
 }
 
@@ -23,12 +26,8 @@ SSGEAPI SSGE_Texture *SSGE_Texture_Get(uint32_t id) {
     return ptr;
 }
 
-static bool _find_texture_name(void *ptr, void *name) {
-    return strcmp(((SSGE_Texture *)ptr)->name, (char *)name) == 0;
-}
-
 SSGEAPI SSGE_Texture *SSGE_Texture_GetName(const char *name) {
-    SSGE_Texture *ptr = (SSGE_Texture *)SSGE_Array_Find(&_textureList, _find_texture_name, (void *)name);
+    SSGE_Texture *ptr = (SSGE_Texture *)SSGE_Array_GetName(&_textureList, name);
     if (ptr == NULL) 
         SSGE_ErrorEx("Texture not found: %s", name)
     return ptr;
@@ -40,34 +39,35 @@ SSGEAPI void SSGE_Texture_Anchor(SSGE_Texture *texture, int x, int y) {
 }
 
 SSGEAPI void SSGE_Texture_Draw(SSGE_Texture *texture, int x, int y, int width, int height) {
-    _SSGE_RenderData *renderData = (_SSGE_RenderData *)malloc(sizeof(_SSGE_RenderData));
-    *renderData = (_SSGE_RenderData){
+    markDamage(x, y, width, height);
+    SSGE_RenderQueue_Push(&texture->queue, &(_SSGE_RenderData){
         .dest = {
             .x = x,
             .y = y,
             .w = width,
             .h = height
         },
-        .once = true
-    };
-    SSGE_Array_Add(&texture->queue, renderData);
+        .layer = _drawLayer,
+        .depth = _drawDepth
+    });
 }
 
 SSGEAPI void SSGE_Texture_DrawEx(SSGE_Texture *texture, int x, int y, int width, int height, double angle, SSGE_Point center, SSGE_Flip flip) {
-    _SSGE_RenderData *renderData = (_SSGE_RenderData *)malloc(sizeof(_SSGE_RenderData));
-    *renderData = (_SSGE_RenderData){
+    _SSGE_RenderData data = {
         .dest = {
             .x = x,
             .y = y,
             .w = width,
             .h = height
         },
-        .once = true,
         .angle = angle,
         .rotationCenter = center,
-        .flip = flip
+        .flip = flip,
+        .layer = _drawLayer,
+        .depth = _drawDepth
     };
-    SSGE_Array_Add(&texture->queue, renderData);
+    markDrawDamage(&data);
+    SSGE_RenderQueue_Push(&texture->queue, &data);
 }
 
 SSGEAPI void SSGE_Texture_Destroy(uint32_t id) {
@@ -78,7 +78,7 @@ SSGEAPI void SSGE_Texture_Destroy(uint32_t id) {
 }
 
 SSGEAPI void SSGE_Texture_DestroyName(const char *name) {
-    SSGE_Texture *texture = SSGE_Array_FindPop(&_textureList, _find_texture_name, (void *)name);
+    SSGE_Texture *texture = SSGE_Array_PopName(&_textureList, name);
     if (texture == NULL) 
         SSGE_ErrorEx("Texture not found: %s", name)
     destroyTexture(texture);
@@ -86,5 +86,6 @@ SSGEAPI void SSGE_Texture_DestroyName(const char *name) {
 
 SSGEAPI void SSGE_Texture_DestroyAll() {
     SSGE_Array_Destroy(&_textureList, (SSGE_DestroyData)destroyTexture);
-    SSGE_Array_Create(&_textureList);
+    SSGE_Array_CreateSlotMap(&_textureList, _engine.textureCapacity);
+    SSGE_Array_IndexNames(&_textureList);
 }
@@ -46,8 +46,9 @@ SSGEAPI SSGE_Texture *SSGE_Tilemap_GetTileAsTexture(SSGE_Tilemap *tilemap, uint1
     if (texture->texture == NULL)
         SSGE_Error("Failed to allocate memory for texture")
 
+    SDL_Rect src = {col * (tilemap->tileWidth + tilemap->spacing), row * (tilemap->tileHeight + tilemap->spacing), tilemap->tileWidth, tilemap->tileHeight};
     SDL_SetRenderTarget(_engine.renderer, texture->texture);
-    SSGE_Tilemap_DrawTile(tilemap, row, col, 0, 0);
+    SDL_RenderCopy(_engine.renderer, tilemap->texture, &src, NULL);
     SDL_SetRenderTarget(_engine.renderer, NULL);
 
     _initTextureFields(texture);
@@ -62,7 +63,7 @@ SSGEAPI void SSGE_Tilemap_DrawTile(SSGE_Tilemap *tilemap, uint16_t row, uint16_t
 
     SDL_Rect src = {col * (tilemap->tileWidth + tilemap->spacing), row * (tilemap->tileHeight + tilemap->spacing), tilemap->tileWidth, tilemap->tileHeight};
     SDL_Rect dest = {x, y, tilemap->tileWidth, tilemap->tileHeight};
-    SDL_RenderCopy(_engine.renderer, tilemap->texture, &src, &dest);
+    if (cameraApply(&dest)) SDL_RenderCopy(_engine.renderer, tilemap->texture, &src, &dest);
 }
 
 SSGEAPI void SSGE_Tilemap_DrawTileSize(SSGE_Tilemap *tilemap, uint16_t row, uint16_t col, int x, int y, uint16_t width, uint16_t height) {
@@ -71,19 +72,19 @@ SSGEAPI void SSGE_Tilemap_DrawTileSize(SSGE_Tilemap *tilemap, uint16_t row, uint
 
     SDL_Rect src = {col * (tilemap->tileWidth + tilemap->spacing), row * (tilemap->tileHeight + tilemap->spacing), tilemap->tileWidth, tilemap->tileHeight};
     SDL_Rect dest = {x, y, width, height};
-    SDL_RenderCopy(_engine.renderer, tilemap->texture, &src, &dest);
+    if (cameraApply(&dest)) SDL_RenderCopy(_engine.renderer, tilemap->texture, &src, &dest);
 }
 
 SSGEAPI void SSGE_Tilemap_DrawTileAlt(SSGE_Tile *tile, int x, int y) {
     SDL_Rect src = {tile->col * (tile->tilemap->tileWidth + tile->tilemap->spacing), tile->row * (tile->tilemap->tileHeight + tile->tilemap->spacing), tile->tilemap->tileWidth, tile->tilemap->tileHeight};
     SDL_Rect dest = {x, y, tile->tilemap->tileWidth, tile->tilemap->tileHeight};
-    SDL_RenderCopy(_engine.renderer, tile->tilemap->texture, &src, &dest);
+    if (cameraApply(&dest)) SDL_RenderCopy(_engine.renderer, tile->tilemap->texture, &src, &dest);
 }
 
 SSGEAPI void SSGE_Tilemap_DrawTileSizeAlt(SSGE_Tile *tile, int x, int y, uint16_t width, uint16_t height) {
     SDL_Rect src = {tile->col * (tile->tilemap->tileWidth + tile->tilemap->spacing), tile->row * (tile->tilemap->tileHeight + tile->tilemap->spacing), tile->tilemap->tileWidth, tile->tilemap->tileHeight};
     SDL_Rect dest = {x, y, width, height};
-    SDL_RenderCopy(_engine.renderer, tile->tilemap->texture, &src, &dest);
+    if (cameraApply(&dest)) SDL_RenderCopy(_engine.renderer, tile->tilemap->texture, &src, &dest);
 }
 
 SSGEAPI void SSGE_Tilemap_DestroyTile(SSGE_Tile *tile) {
@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "SSGE_local.h"
+#include "SSGE/SSGE_trace.h"
+
+// The buffer of the thread, only valid for the trace of `_bufferGeneration`
+static _Thread_local _SSGE_TraceBuffer *_buffer = NULL;
+static _Thread_local uint32_t _bufferGeneration = 0;
+
+static _SSGE_TraceChunk *_newChunk() {
+    _SSGE_TraceChunk *chunk = (_SSGE_TraceChunk *)calloc(1, sizeof(_SSGE_TraceChunk));
+    if (chunk == NULL)
+        SSGE_Error("Failed to allocate memory for trace")
+    return chunk;
+}
+
+static _SSGE_TraceBuffer *_threadBuffer() {
+    if (_buffer != NULL && _bufferGeneration == _trace.generation) return _buffer;
+
+    _buffer = (_SSGE_TraceBuffer *)calloc(1, sizeof(_SSGE_TraceBuffer));
+    if (_buffer == NULL)
+        SSGE_Error("Failed to allocate memory for trace")
+    _buffer->head = _buffer->tail = _newChunk();
+    _buffer->thread = (uint32_t)SDL_ThreadID();
+    _bufferGeneration = _trace.generation;
+
+    SDL_AtomicLock(&_trace.lock);
+    _buffer->next = _trace.buffers;
+    _trace.buffers = _buffer;
+    SDL_AtomicUnlock(&_trace.lock);
+    return _buffer;
+}
+
+// Only called by the thread of the buffer, the chunks are never moved so the flush can read them meanwhile
+static void _push(_SSGE_TraceBuffer *buffer, const _SSGE_TraceEvent *event) {
+    _SSGE_TraceChunk *chunk = buffer->tail;
+    int count = SDL_AtomicGet(&chunk->count);
+    if (count == _SSGE_TRACE_CHUNK_SIZE) {
+        _SSGE_TraceChunk *next = _newChunk();
+        SDL_AtomicSetPtr((void **)&chunk->next, next);
+        buffer->tail = chunk = next;
+        count = 0;
+    }
+    chunk->events[count] = *event;
+    SDL_AtomicSet(&chunk->count, count + 1); // Publishes the event
+}
+
+// Writes a JSON string
+static void _writeString(FILE *file, const char *string) {
+    fputc('"', file);
+    for (; *string; string++) {
+        unsigned char c = (unsigned char)*string;
+        if (c == '"' || c == '\\') fprintf(file, "\\%c", c);
+        else if (c < 0x20) fprintf(file, "\\u%04x", c);
+        else fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+SSGEAPI void SSGE_Trace_Start(const char *filename) {
+    if (_trace.file != NULL)
+        SSGE_Error("Trace already started")
+
+    _trace.file = fopen(filename, "w");
+    if (_trace.file == NULL)
+        SSGE_ErrorEx("Failed to open trace file: %s", filename)
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", _trace.file);
+
+    _trace.first = true;
+    _trace.start = SDL_GetPerformanceCounter();
+    ++_trace.generation;
+    _trace.enabled = true;
+}
+
+SSGEAPI void SSGE_Trace_Flush() {
+    if (_trace.file == NULL) return;
+
+    double toUs = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+    SDL_AtomicLock(&_trace.lock);
+    for (_SSGE_TraceBuffer *buffer = _trace.buffers; buffer != NULL; buffer = buffer->next) {
+        _SSGE_TraceChunk *chunk = buffer->head;
+        while (true) {
+            // Only the events published by the thread are read, it keeps writing after them
+            uint32_t count = (uint32_t)SDL_AtomicGet(&chunk->count);
+            for (uint32_t i = chunk->flushed; i < count; i++) {
+                _SSGE_TraceEvent event = chunk->events[i];
+                if (event.begin < _trace.start) event.begin = _trace.start; // The frame started before the trace
+                fputs(_trace.first ? "\n{\"name\":" : ",\n{\"name\":", _trace.file);
+                _writeString(_trace.file, event.name);
+                fprintf(_trace.file, ",\"cat\":\"SSGE\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                    (double)(event.begin - _trace.start) * toUs, (double)(event.end - event.begin) * toUs, buffer->thread);
+                _trace.first = false;
+            }
+            chunk->flushed = count;
+
+            // A full chunk followed by another one is no longer used by the thread
+            _SSGE_TraceChunk *next = SDL_AtomicGetPtr((void **)&chunk->next);
+            if (count < _SSGE_TRACE_CHUNK_SIZE || next == NULL) break;
+            buffer->head = next;
+            free(chunk);
+            chunk = next;
+        }
+    }
+    SDL_AtomicUnlock(&_trace.lock);
+    fflush(_trace.file);
+}
+
+SSGEAPI void SSGE_Trace_Stop() {
+    if (_trace.file == NULL) return;
+
+    _trace.enabled = false;
+    SSGE_Trace_Flush();
+    fputs("\n]}\n", _trace.file);
+    fclose(_trace.file);
+    _trace.file = NULL;
+
+    _SSGE_TraceBuffer *buffer = _trace.buffers;
+    while (buffer != NULL) {
+        _SSGE_TraceBuffer *next = buffer->next;
+        _SSGE_TraceChunk *chunk = buffer->head;
+        while (chunk != NULL) {
+            _SSGE_TraceChunk *nextChunk = chunk->next;
+            free(chunk);
+            chunk = nextChunk;
+        }
+        free(buffer);
+        buffer = next;
+    }
+    _trace.buffers = NULL;
+}
+
+SSGEAPI void SSGE_Trace_Begin(const char *name) {
+    if (!_trace.enabled) return;
+    _SSGE_TraceBuffer *buffer = _threadBuffer();
+
+    // Zones nested too deep are dropped, but still counted to match their end
+    if (buffer->depth < _SSGE_TRACE_MAX_DEPTH)
+        buffer->stack[buffer->depth] = (_SSGE_TraceEvent){.name = name, .begin = SDL_GetPerformanceCounter()};
+    ++buffer->depth;
+}
+
+SSGEAPI void SSGE_Trace_End() {
+    if (!_trace.enabled) return;
+    _SSGE_TraceBuffer *buffer = _threadBuffer();
+    if (buffer->depth == 0) return; // Opened before the trace started
+
+    if (--buffer->depth < _SSGE_TRACE_MAX_DEPTH) {
+        _SSGE_TraceEvent *event = &buffer->stack[buffer->depth];
+        event->end = SDL_GetPerformanceCounter();
+        _push(buffer, event);
+    }
+}
+
+/**
+ * Records a zone whose bounds are already known
+ * \param name The name of the zone
+ * \param begin The performance counter at the beginning of the zone
+ * \param end The performance counter at the end of the zone
+ */
+void traceZone(const char *name, uint64_t begin, uint64_t end) {
+    if (!_trace.enabled) return;
+    _push(_threadBuffer(), &(_SSGE_TraceEvent){name, begin, end});
+}
@@ -0,0 +1,139 @@
+#include <stdlib.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "SSGE_local.h"
+#include "SSGE_error.h"
+
+#define _GROWTH_FACTOR 2
+
+#define _REALLOC(ptr, type, size) {\
+    type *newPtr = (type *)realloc(ptr, sizeof(type) * (size));\
+    if (newPtr == NULL)\
+        SSGE_Error("Failed to allocate memory for object transforms")\
+    ptr = newPtr;\
+}
+
+/**
+ * Creates object transforms
+ * \param transforms The transforms to initialize
+ * \param size The initial number of transforms
+ */
+SSGEAPI void SSGE_Transforms_Create(_SSGE_ObjectTransforms *transforms, uint32_t size) {
+    *transforms = (_SSGE_ObjectTransforms){0};
+    SSGE_Transforms_Reserve(transforms, size);
+}
+
+/**
+ * Grows object transforms to hold at least a number of transforms
+ * \param transforms The transforms
+ * \param size The number of transforms to hold
+ */
+SSGEAPI void SSGE_Transforms_Reserve(_SSGE_ObjectTransforms *transforms, uint32_t size) {
+    if (size <= transforms->size) return;
+
+    uint32_t newSize = transforms->size ? transforms->size : size;
+    while (newSize < size)
+        newSize = newSize > UINT32_MAX / _GROWTH_FACTOR ? size : newSize * _GROWTH_FACTOR;
+
+    _REALLOC(transforms->x, int32_t, newSize)
+    _REALLOC(transforms->y, int32_t, newSize)
+    _REALLOC(transforms->width, int32_t, newSize)
+    _REALLOC(transforms->height, int32_t, newSize)
+    _REALLOC(transforms->hidden, uint8_t, newSize)
+    _REALLOC(transforms->hitbox, uint8_t, newSize)
+    transforms->size = newSize;
+}
+
+/**
+ * Sets a transform
+ * \param transforms The transforms
+ * \param pos The position of the transform
+ * \param x The x coordinate
+ * \param y The y coordinate
+ * \param width The width
+ * \param height The height
+ * \param hitbox If the object has a hitbox
+ */
+SSGEAPI void SSGE_Transforms_Set(_SSGE_ObjectTransforms *transforms, uint32_t pos, int x, int y, int width, int height, bool hitbox) {
+    transforms->x[pos] = x;
+    transforms->y[pos] = y;
+    transforms->width[pos] = width;
+    transforms->height[pos] = height;
+    transforms->hidden[pos] = false;
+    transforms->hitbox[pos] = hitbox;
+}
+
+/**
+ * Copies a transform to another position
+ * \param transforms The transforms
+ * \param from The position of the transform to copy
+ * \param to The position to copy the transform to
+ */
+SSGEAPI void SSGE_Transforms_Copy(_SSGE_ObjectTransforms *transforms, uint32_t from, uint32_t to) {
+    transforms->x[to] = transforms->x[from];
+    transforms->y[to] = transforms->y[from];
+    transforms->width[to] = transforms->width[from];
+    transforms->height[to] = transforms->height[from];
+    transforms->hidden[to] = transforms->hidden[from];
+    transforms->hitbox[to] = transforms->hitbox[from];
+}
+
+/**
+ * Finds the transforms containing a point
+ * \param transforms The transforms
+ * \param first The position of the first transform to search
+ * \param count The number of transforms
+ * \param x The x coordinate of the point
+ * \param y The y coordinate of the point
+ * \param found Where to store the positions of the transforms found
+ * \param size The maximum number of positions to store
+ * \return The number of positions stored
+ */
+SSGEAPI uint32_t SSGE_Transforms_FindPoint(_SSGE_ObjectTransforms *transforms, uint32_t first, uint32_t count, int x, int y, uint32_t *found, uint32_t size) {
+    uint32_t n = 0;
+    uint32_t i = first;
+
+#ifdef __SSE2__
+    // 4 transforms at a time: x <= px && px <= x + w && y <= py && py <= y + h
+    __m128i px = _mm_set1_epi32(x);
+    __m128i py = _mm_set1_epi32(y);
+    for (; i + 4 <= count && n < size; i += 4) {
+        __m128i left = _mm_loadu_si128((const __m128i *)&transforms->x[i]);
+        __m128i top = _mm_loadu_si128((const __m128i *)&transforms->y[i]);
+        __m128i right = _mm_add_epi32(left, _mm_loadu_si128((const __m128i *)&transforms->width[i]));
+        __m128i bottom = _mm_add_epi32(top, _mm_loadu_si128((const __m128i *)&transforms->height[i]));
+
+        __m128i outside = _mm_or_si128(
+            _mm_or_si128(_mm_cmpgt_epi32(left, px), _mm_cmpgt_epi32(px, right)),
+            _mm_or_si128(_mm_cmpgt_epi32(top, py), _mm_cmpgt_epi32(py, bottom))
+        );
+        int mask = ~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xF;
+        for (; mask != 0 && n < size; mask &= mask - 1)
+            found[n++] = i + __builtin_ctz(mask);
+    }
+#endif
+
+    for (; i < count && n < size; i++) {
+        if (x >= transforms->x[i] && x <= transforms->x[i] + transforms->width[i] &&
+            y >= transforms->y[i] && y <= transforms->y[i] + transforms->height[i])
+            found[n++] = i;
+    }
+    return n;
+}
+
+/**
+ * Destroys object transforms
+ * \param transforms The transforms to destroy
+ */
+SSGEAPI void SSGE_Transforms_Destroy(_SSGE_ObjectTransforms *transforms) {
+    free(transforms->x);
+    free(transforms->y);
+    free(transforms->width);
+    free(transforms->height);
+    free(transforms->hidden);
+    free(transforms->hitbox);
+    *transforms = (_SSGE_ObjectTransforms){0};
+}
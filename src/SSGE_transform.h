@@ -0,0 +1,76 @@
+// Internal object transforms functions
+
+#ifndef __SSGE_TRANSFORM_H__
+#define __SSGE_TRANSFORM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "SSGE/SSGE_config.h"
+#include "SSGE_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern _SSGE_ObjectTransforms _objectTransforms;
+
+/**
+ * Create object transforms
+ * \param transforms The transforms to initialize
+ * \param size The initial number of transforms
+ */
+SSGEAPI void SSGE_Transforms_Create(_SSGE_ObjectTransforms *transforms, uint32_t size);
+
+/**
+ * Grow object transforms to hold at least a number of transforms
+ * \param transforms The transforms
+ * \param size The number of transforms to hold
+ */
+SSGEAPI void SSGE_Transforms_Reserve(_SSGE_ObjectTransforms *transforms, uint32_t size);
+
+/**
+ * Set a transform
+ * \param transforms The transforms
+ * \param pos The position of the transform, must be lower than the size
+ * \param x The x coordinate
+ * \param y The y coordinate
+ * \param width The width
+ * \param height The height
+ * \param hitbox If the object has a hitbox
+ */
+SSGEAPI void SSGE_Transforms_Set(_SSGE_ObjectTransforms *transforms, uint32_t pos, int x, int y, int width, int height, bool hitbox);
+
+/**
+ * Copy a transform to another position
+ * \param transforms The transforms
+ * \param from The position of the transform to copy
+ * \param to The position to copy the transform to
+ */
+SSGEAPI void SSGE_Transforms_Copy(_SSGE_ObjectTransforms *transforms, uint32_t from, uint32_t to);
+
+/**
+ * Find the transforms containing a point
+ * \param transforms The transforms
+ * \param first The position of the first transform to search
+ * \param count The number of transforms
+ * \param x The x coordinate of the point
+ * \param y The y coordinate of the point
+ * \param found Where to store the positions of the transforms found
+ * \param size The maximum number of positions to store
+ * \return The number of positions stored
+ * \note Edges are inclusive, the hidden and hitbox flags are ignored
+ */
+SSGEAPI uint32_t SSGE_Transforms_FindPoint(_SSGE_ObjectTransforms *transforms, uint32_t first, uint32_t count, int x, int y, uint32_t *found, uint32_t size);
+
+/**
+ * Destroy object transforms
+ * \param transforms The transforms to destroy
+ */
+SSGEAPI void SSGE_Transforms_Destroy(_SSGE_ObjectTransforms *transforms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SSGE_TRANSFORM_H__
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #include "SSGE_local.h"
 #include "SSGE/SSGE_config.h"
@@ -28,26 +29,314 @@ typedef struct _SSGE_Engine {
     bool            resizable;      // If the window is resizable
     bool            isRunning;      // The running state of the engine
     bool            initialized;    // If the `SSGE_Engine` has been initialized
+    bool            partialRedraw;  // If only the damaged regions are redrawn
+    bool            idle;           // If the loop blocks until something happens
+    bool            hidden;         // If the window is minimized or hidden
+    uint64_t        wakeup;         // The performance counter when the idle loop must wake up, 0 for none
+    SDL_Texture     *backbuffer;    // The persistent render target of the partial redraw mode
+    SDL_Surface     *offscreen;     // The surface drawn by the renderer in offscreen headless mode
+    SSGE_HeadlessMode headless;     // The headless mode
+    bool            audio;          // If the audio mixer is initialized
+    uint32_t        textureCapacity;// The initial capacity of the texture registry
+    uint32_t        objectCapacity; // The initial capacity of the object registry
 } SSGE_Engine;
 
+// Name index struct (hash index over the names of the elements of an array)
+typedef struct _SSGE_NameIndex {
+    struct _SSGE_NameEntry {
+        const char  *name;  // The name (borrowed from the first element holding it), NULL if the entry is empty
+        uint32_t    hash;   // The hash of the name
+        uint32_t    first;  // The index of the first element holding the name
+    }           *entries;   // Open addressing table of the names
+    uint32_t    size;       // Size of the table (power of two)
+    uint32_t    count;      // Number of names in the table
+    uint32_t    *next;      // Next element holding the same name, for each index
+    uint32_t    *prev;      // Previous element holding the same name, for each index
+    uint32_t    linkSize;   // Size of the `next` and `prev` arrays
+} _SSGE_NameIndex;
+
+// Slot table struct (stable ids for densely packed elements)
+typedef struct _SSGE_SlotTable {
+    uint32_t    *slots;     // Position of the element of each slot, or next unused slot
+    uint32_t    *owners;    // Slot of the element at each position
+    uint8_t     *generations; // Generation of each slot, incremented when its element is removed
+    uint32_t    size;       // Number of positions of the table
+    uint32_t    slotSize;   // Size of the `slots` and `generations` arrays
+    uint32_t    slotCount;  // Number of slots ever used
+    uint32_t    freeSlot;   // Oldest unused slot, `UINT32_MAX` if there is none
+    uint32_t    freeTail;   // Newest unused slot, `UINT32_MAX` if there is none
+    uint32_t    freeCount;  // Number of unused slots
+    uint32_t    minFree;    // Number of unused slots kept before reusing the oldest one
+} _SSGE_SlotTable;
+
 // Array struct
 typedef struct _SSGE_Array {
-    void        **array;    // Array of pointers
+    void        **array;    // Array of pointers (densely packed if the array is a slot map)
     uint32_t    size;       // Size of the array
     uint32_t    count;      // Number of elements in the array
     uint32_t    *indexes;   // Pointer to the pile of unused indexes
     uint32_t    idxSize;    // The size of the pile of indexes
     uint32_t    idxCount;   // Number of unused indexes
+    _SSGE_SlotTable *slots; // Slot table of the ids, NULL if the array is not a slot map
+    _SSGE_NameIndex *names; // Index of the element names, NULL if the array is not indexed by name
 } SSGE_Array;
 
+// Render data struct (one render call of a texture)
+typedef struct _SSGE_RenderData {
+    SDL_Rect    dest;
+    SSGE_Flip   flip;
+    SSGE_Point  rotationCenter;
+    double      angle;
+    int16_t     layer;  // The layer, lower layers are drawn first
+    uint16_t    depth;  // The depth in the layer, lower depths are drawn first
+} _SSGE_RenderData;
+
+#define _SSGE_RENDER_QUEUE_INLINE_SIZE 2
+
+// Render queue struct (render calls of a texture, stored by value, allocated on first use)
+typedef struct _SSGE_RenderQueue {
+    _SSGE_RenderData    *persistent;    // Render data drawn every frame (bound objects), densely packed
+    uint32_t            persistentCount; // Number of persistent render data
+    uint32_t            persistentSize; // Size of the persistent region
+    _SSGE_SlotTable     slots;          // Ids of the persistent render data
+    _SSGE_RenderData    *once;          // Render data drawn on the next frame only, `onceInline` until it outgrows it
+    uint32_t            onceCount;      // Number of render data drawn on the next frame only
+    uint32_t            onceSize;       // Size of the one-shot region
+    _SSGE_RenderData    onceInline[_SSGE_RENDER_QUEUE_INLINE_SIZE]; // Inline storage of the one-shot region
+} _SSGE_RenderQueue;
+
+// Sprite batch struct (quads of one SDL_Texture submitted with a single SDL_RenderGeometry call)
+typedef struct _SSGE_SpriteBatch {
+    SDL_Renderer    *renderer;      // The renderer the batch is submitted to
+    bool            enabled;        // If geometry is supported, otherwise every sprite is copied on its own
+    SDL_Texture     *texture;       // The texture of the queued quads
+    float           invWidth;       // 1 / width of `texture`
+    float           invHeight;      // 1 / height of `texture`
+    SDL_Color       color;          // The color and alpha mod of `texture`
+    float           scale;          // The scale applied to the sprites
+    float           offsetX;        // The x offset applied to the sprites, after the scale
+    float           offsetY;        // The y offset applied to the sprites, after the scale
+    SDL_Vertex      *vertices;      // The vertices of the queued quads, 4 per quad
+    int             *indices;       // The indices of the queued quads, 6 per quad
+    uint32_t        count;          // The number of queued quads
+    uint32_t        size;           // The number of quads the buffers can hold
+} _SSGE_SpriteBatch;
+
+// Render command struct (one sprite of the frame, ordered by its sort key)
+typedef struct _SSGE_RenderCommand {
+    uint64_t                key;        // The sort key: layer, depth, texture, blend mode (most to least significant)
+    SDL_Texture             *texture;   // The texture to draw
+    const SDL_Rect          *src;       // The source rect in the texture, NULL for the whole texture
+    const _SSGE_RenderData  *data;      // The render data
+} _SSGE_RenderCommand;
+
+// Command queue struct (the render commands of a frame, allocated in the frame arena)
+typedef struct _SSGE_CommandQueue {
+    _SSGE_RenderCommand *commands;      // The render commands
+    uint32_t            count;          // The number of render commands
+    uint32_t            size;           // The number of render commands the queue can hold
+    SDL_Texture         *lastTexture;   // The texture of the last pushed command
+    uint8_t             blendKey;       // The blend part of the sort key of `lastTexture`
+} _SSGE_CommandQueue;
+
+// Spatial grid node struct (a persistent render data placed in the grid)
+typedef struct _SSGE_GridNode {
+    SSGE_Texture    *texture;   // The texture of the render data, NULL if the node is free
+    uint32_t        renderId;   // The id of the render data in the texture render queue
+    int32_t         cellX;      // The x coordinate of the cell holding the node
+    int32_t         cellY;      // The y coordinate of the cell holding the node
+    bool            large;      // If the node is larger than a cell and held by the large list
+    uint32_t        index;      // The position of the node in its cell, or the next free node
+} _SSGE_GridNode;
+
+// Spatial grid cell struct
+typedef struct _SSGE_GridCell {
+    int32_t     x;          // The x coordinate of the cell
+    int32_t     y;          // The y coordinate of the cell
+    bool        used;       // If the entry of the table holds a cell
+    uint32_t    *nodes;     // The nodes in the cell
+    uint32_t    count;      // The number of nodes in the cell
+    uint32_t    size;       // The size of the node array
+} _SSGE_GridCell;
+
+// Spatial grid struct (uniform hash grid over the persistent render data, by top-left corner)
+typedef struct _SSGE_SpatialGrid {
+    _SSGE_GridNode  *nodes;     // The nodes
+    uint32_t        nodeCount;  // The number of nodes handed out, free ones included
+    uint32_t        nodeSize;   // The size of the node array
+    uint32_t        freeNode;   // The first free node, UINT32_MAX if none
+    _SSGE_GridCell  *cells;     // The cells, open addressing with linear probing
+    uint32_t        cellCount;  // The number of cells
+    uint32_t        cellSize;   // The size of the cell table, a power of 2
+    _SSGE_GridCell  large;      // The nodes larger than a cell, tested every query
+} _SSGE_SpatialGrid;
+
+// Camera struct (maps the world to a region of the window)
+typedef struct _SSGE_Camera {
+    int         x;          // The x coordinate of the world point at the top-left corner of the viewport
+    int         y;          // The y coordinate of the world point at the top-left corner of the viewport
+    float       zoom;       // The zoom of the camera
+    SDL_Rect    viewport;   // The region of the window the camera draws in, a size of 0 extends to the window
+} _SSGE_Camera;
+
+#define _SSGE_PROFILER_FRAMES 120
+
+// Profiler struct (time spent in each phase of the recent frames)
+typedef struct _SSGE_Profiler {
+    bool        enabled;    // If the frames are profiled
+    bool        overlay;    // If the overlay is drawn
+    uint64_t    start;      // The performance counter at the beginning of the current frame
+    uint64_t    last;       // The performance counter at the end of the last profiled phase
+    uint64_t    current[SSGE_PHASE_COUNT]; // The time spent in each phase of the current frame
+    uint64_t    frames[_SSGE_PROFILER_FRAMES][SSGE_PHASE_COUNT]; // Ring buffer of the recent frames
+    uint32_t    next;       // The position of the next frame in the ring buffer
+    uint32_t    count;      // The number of recorded frames
+} _SSGE_Profiler;
+
+#define _SSGE_TRACE_MAX_DEPTH 64
+
+// Trace event struct (a complete zone)
+typedef struct _SSGE_TraceEvent {
+    const char  *name;      // The name of the zone
+    uint64_t    begin;      // The performance counter at the beginning of the zone
+    uint64_t    end;        // The performance counter at the end of the zone
+} _SSGE_TraceEvent;
+
+#define _SSGE_TRACE_CHUNK_SIZE 256
+
+// Trace chunk struct (closed zones of a thread, filled by the thread and read by the flush)
+typedef struct _SSGE_TraceChunk {
+    _SSGE_TraceEvent        events[_SSGE_TRACE_CHUNK_SIZE]; // The closed zones
+    SDL_atomic_t            count;      // The number of events published by the thread
+    uint32_t                flushed;    // The number of events written by the flush
+    struct _SSGE_TraceChunk *next;      // The next chunk, published by the thread once this one is full
+} _SSGE_TraceChunk;
+
+// Trace buffer struct (the zones recorded by a thread)
+typedef struct _SSGE_TraceBuffer {
+    _SSGE_TraceChunk        *head;      // The oldest chunk not entirely written, only used by the flush
+    _SSGE_TraceChunk        *tail;      // The chunk being filled, only used by the thread
+    _SSGE_TraceEvent        stack[_SSGE_TRACE_MAX_DEPTH]; // The open zones
+    uint32_t                depth;      // The number of open zones
+    uint32_t                thread;     // The id of the thread
+    struct _SSGE_TraceBuffer *next;     // The buffer of the next thread
+} _SSGE_TraceBuffer;
+
+// Trace struct (export of the zones in Chrome trace-event JSON)
+typedef struct _SSGE_Trace {
+    bool                enabled;    // If zones are recorded
+    bool                first;      // If no event was written to the file yet
+    uint32_t            generation; // Incremented by each trace, buffers of previous traces are replaced
+    FILE                *file;      // The trace file
+    uint64_t            start;      // The performance counter when the trace started
+    SDL_SpinLock        lock;       // Protects the list of buffers, and serializes the flushes
+    _SSGE_TraceBuffer   *buffers;   // The buffers of every thread that recorded a zone
+} _SSGE_Trace;
+
+#define _SSGE_STATIC_LAYERS_MAX 8
+
+// Static layer struct (layer whose persistent render data are cached in a texture)
+typedef struct _SSGE_StaticLayer {
+    int16_t             layer;      // The layer number
+    bool                dirty;      // If the cache must be redrawn on the next frame
+    SDL_Texture         *cache;     // The render target holding the layer, the size of the camera viewport
+    int                 width;      // The width of the cache
+    int                 height;     // The height of the cache
+    _SSGE_CommandQueue  commands;   // The render commands of the layer, only filled when the cache is redrawn
+} _SSGE_StaticLayer;
+
+// Static layer list struct
+typedef struct _SSGE_StaticLayers {
+    _SSGE_StaticLayer   layers[_SSGE_STATIC_LAYERS_MAX]; // The static layers
+    uint32_t            count;  // The number of static layers
+} _SSGE_StaticLayers;
+
+#define _SSGE_DAMAGE_MAX_RECTS 16
+
+// Damage list struct (regions of the window to redraw in partial redraw mode)
+typedef struct _SSGE_DamageList {
+    SDL_Rect    rects[_SSGE_DAMAGE_MAX_RECTS]; // The damaged regions, disjoint
+    uint32_t    count;  // The number of damaged regions
+    bool        full;   // If the whole window is damaged
+} _SSGE_DamageList;
+
+// Arena block struct
+typedef struct _SSGE_ArenaBlock {
+    struct _SSGE_ArenaBlock *next;  // The next block of the arena
+    size_t                  size;   // The size of the block data
+    size_t                  used;   // The number of bytes used in the block
+} _SSGE_ArenaBlock;
+
+// Arena struct (bump allocator, reset as a whole)
+typedef struct _SSGE_Arena {
+    _SSGE_ArenaBlock    *first;     // The first block of the arena
+    _SSGE_ArenaBlock    *current;   // The block allocations are made from
+    size_t              used;       // The number of bytes used since the last reset, skipped block ends included
+    size_t              highWater;  // The highest number of bytes used between two resets
+    size_t              blockSize;  // The minimum size of a block
+} _SSGE_Arena;
+
+// Pool struct (fixed-size blocks allocated in slabs)
+typedef struct _SSGE_Pool {
+    void        **slabs;        // The slabs of the pool
+    uint32_t    slabCount;      // The number of slabs
+    uint32_t    slabSize;       // The size of the slab array
+    size_t      blockSize;      // The size of a block
+    uint32_t    slabBlocks;     // The number of blocks in a slab
+    uint32_t    slabUsed;       // The number of blocks handed out from the last slab
+    void        *freeList;      // The freed blocks, linked through their first bytes
+} _SSGE_Pool;
+
+// Interned string (shared by every resource with the same name)
+typedef struct _SSGE_InternString {
+    uint32_t    hash;       // The hash of the string
+    uint32_t    refs;       // The number of names referencing the string
+    char        string[];   // The string
+} _SSGE_InternString;
+
+// Intern table struct
+typedef struct _SSGE_InternTable {
+    _SSGE_InternString  **entries;  // The strings, open addressing with linear probing
+    uint32_t            size;       // The size of the table, a power of 2
+    uint32_t            count;      // The number of strings
+    size_t              bytes;      // The number of bytes used by the strings
+} _SSGE_InternTable;
+
+// Atlas entry struct (a texture packed in an atlas)
+typedef struct _SSGE_AtlasEntry {
+    SSGE_Texture    *texture;       // The texture
+    SDL_Texture     *source;        // The SDL_Texture the texture is copied from when the atlas is built
+    SDL_Surface     *surface;       // The image of the texture if it was loaded by the atlas, its page is then built without render target
+    SDL_Rect        src;            // The source rect in `source`
+    bool            ownsSource;     // If `source` is destroyed when the atlas is built
+    uint32_t        page;           // The page of the texture once built
+} _SSGE_AtlasEntry;
+
+// Atlas struct (textures packed in a few large SDL_Textures)
+typedef struct _SSGE_Atlas {
+    uint16_t            pageWidth;  // The width of a page
+    uint16_t            pageHeight; // The height of a page
+    _SSGE_AtlasEntry    *entries;   // The textures of the atlas, sorted by page once built
+    uint32_t            count;      // The number of textures
+    uint32_t            size;       // The size of the entries array
+    SDL_Texture         **pages;    // The pages of the atlas
+    uint32_t            pageCount;  // The number of pages
+    uint32_t            refs;       // The number of textures, plus one until the atlas is built
+    bool                built;      // If the atlas has been built
+    uint32_t            drawnFrame; // The last frame the textures of the atlas were drawn
+} SSGE_Atlas;
+
 // Texture struct
 typedef struct _SSGE_Texture {
-    char        *name;      // The name of the texture
-    uint32_t    id;         // The id of the texture
-    SDL_Texture *texture;   // The SDL_Texture
-    int         anchorX;    // Anchor x coordinate (relative to the texture)
-    int         anchorY;    // Anchor y coordinate (relative to the texture)
-    SSGE_Array  queue;      // Queue of every render call for this texture
+    char                *name;      // The name of the texture
+    uint32_t            id;         // The id of the texture
+    SDL_Texture         *texture;   // The SDL_Texture
+    SDL_Rect            src;        // The source rect in the SDL_Texture, `w == 0` for the whole texture
+    SSGE_Atlas          *atlas;     // The atlas of the texture, NULL if the texture owns its SDL_Texture
+    uint32_t            sortKey;    // The texture part of the sort key of the render data, set each frame
+    int                 anchorX;    // Anchor x coordinate (relative to the texture)
+    int                 anchorY;    // Anchor y coordinate (relative to the texture)
+    _SSGE_RenderQueue   queue;      // Queue of every render call for this texture
 } SSGE_Texture;
 
 // Animation struct
@@ -59,7 +348,10 @@ typedef struct _SSGE_Animation {
     union {
         struct _SSGE_AnimationData {
             SDL_Texture **frames;       // An array of the animation frames
-            uint8_t     *frametimes;    // Frametime corresponding to each frames
+            uint32_t    *frametimes;    // Duration of each frame (in microseconds)
+            uint64_t    duration;       // Sum of the durations of the frames (in microseconds)
+            SDL_Texture *sheet;         // The sprite sheet shared by the frames cut from it, NULL if there is none
+            SDL_Rect    *srcRects;      // The source rect of each frame in the sheet, NULL if there is no sheet
             uint32_t    frameCount;     // The number of animation frames
             uint32_t    currentCount;   // The number of frames the animation currently have
             uint16_t    width;          // The width of the frames
@@ -76,6 +368,21 @@ typedef struct _SSGE_Animation {
     };
 } SSGE_Animation;
 
+// Animation instance struct (a copy of a shared animation, drawn from the frame of its clock)
+typedef struct _SSGE_AnimationInstance {
+    int             x;              // The x coordinate of the instance
+    int             y;              // The y coordinate of the instance
+    uint32_t        phase;          // The number of frames the instance is ahead of its clock
+} _SSGE_AnimationInstance;
+
+// Animation clock struct (the instances sharing the playback of an animation state)
+typedef struct _SSGE_AnimationClock {
+    _SSGE_AnimationInstance *instances; // Densely packed instances
+    _SSGE_SlotTable         slots;      // Slot table of the ids of the instances
+    uint32_t                count;      // Number of instances
+    uint32_t                size;       // Size of the instance array
+} _SSGE_AnimationClock;
+
 // Animation state struct
 typedef struct _SSGE_AnimationState {
     SSGE_Animation  *animation;     // The animation to track the animation state
@@ -83,34 +390,50 @@ typedef struct _SSGE_AnimationState {
     int             y;              // The y coordinate at which the animation is played
     uint32_t        loop;           // Number of loops (0 means play once, -1 means indefinitely)
     uint32_t        currentFrame;   // The index of the current frame
-    uint8_t         currentFrameTime; // Elapsed time spent on the current frame (in frames)
+    uint32_t        currentFrameTime; // Elapsed time spent on the current frame (in microseconds)
     bool            reversed;       // If the animation is reversed or not
     bool            pingpong;       // If the animation should pingpong (normal -> reversed)
     bool            isPlaying;      // If the animation is playing or not
+    int16_t         layer;          // The layer the animation is drawn on
+    uint16_t        depth;          // The depth of the animation in its layer
+    _SSGE_AnimationClock *clock;    // The instances drawn from the state, NULL if it is drawn at its own position
 } SSGE_AnimationState;
 
-// Object struct
+// Object struct (the position, size and flags are stored in `_objectTransforms`)
 typedef struct _SSGE_Object {
     char            *name;      // The name of the object
     uint32_t        id;         // The id of the object
-    int             x;          // The x coordinate of the object
-    int             y;          // The y coordinate of the object
-    uint16_t        width;      // The width of the object
-    uint16_t        height;     // The height of the object
-    bool            hitbox;     // If the object has a hitbox
-    bool            hidden;     // If the object is hidden
     SSGE_SpriteType spriteType; // If the sprite is animated or static
     void            *data;      // The data of the object
     void            (*destroyData)(void *); // The function to be called to destroy the data
+    int16_t         layer;      // The layer the sprite of the object is drawn on
+    uint16_t        depth;      // The depth of the sprite of the object in its layer
     union {
         struct {
             SSGE_Texture    *texture;       // The texture of the object
             uint32_t        renderDataIdx;  // The index of the render data in the texture render queue
+            uint32_t        gridNode;       // The node of the render data in the spatial grid
         } texture;
         uint32_t    animation;  // The id of the animation state
+        struct {
+            uint32_t    clock;      // The id of the shared animation state
+            uint32_t    instance;   // The id of the instance, `UINT32_MAX` if hidden
+            uint32_t    phase;      // The phase of the instance
+        } shared;
     };
 } SSGE_Object;
 
+// Object transforms struct (position, size and flags of the objects, indexed like the object list)
+typedef struct _SSGE_ObjectTransforms {
+    int32_t     *x;         // The x coordinates of the objects
+    int32_t     *y;         // The y coordinates of the objects
+    int32_t     *width;     // The widths of the objects
+    int32_t     *height;    // The heights of the objects
+    uint8_t     *hidden;    // If the objects are hidden
+    uint8_t     *hitbox;    // If the objects have a hitbox
+    uint32_t    size;       // The size of the arrays
+} _SSGE_ObjectTransforms;
+
 // Object template struct
 typedef struct _SSGE_ObjectTemplate {
     char            *name;      // The name of the template